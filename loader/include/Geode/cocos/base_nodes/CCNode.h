@@ -1740,6 +1740,8 @@ namespace geode {
         json::Value& value;
 
         AttributeSetEvent(cocos2d::CCNode* node, std::string const& id, json::Value& value);
+
+        std::optional<std::string_view> getRoutingKey() const override;
     };
 
     class GEODE_DLL AttributeSetFilter : public EventFilter<AttributeSetEvent> {
@@ -1750,7 +1752,8 @@ namespace geode {
 		std::string m_targetID;
 	
 	public:
-        ListenerResult handle(utils::MiniFunction<Callback> fn, AttributeSetEvent* event);
+        ListenerResult handle(utils::MiniFunction<Callback> const& fn, AttributeSetEvent* event);
+        std::optional<std::string_view> getRoutingKey() const;
 
 		AttributeSetFilter(std::string const& id);
     };
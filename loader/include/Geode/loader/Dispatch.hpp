@@ -19,13 +19,17 @@ namespace geode {
         DispatchEvent(std::string const& id, Args... args)
           : m_id(id), m_args(std::make_tuple(args...)) {}
         
-        std::tuple<Args...> getArgs() const {
+        std::tuple<Args...> const& getArgs() const {
             return m_args;
         }
 
         std::string getID() const {
             return m_id;
         }
+
+        std::optional<std::string_view> getRoutingKey() const override {
+            return m_id;
+        }
     };
 
     template <class... Args>
@@ -37,13 +41,17 @@ namespace geode {
         using Ev = DispatchEvent<Args...>;
         using Callback = ListenerResult(Args...);
 
-        ListenerResult handle(utils::MiniFunction<Callback> fn, Ev* event) {
+        ListenerResult handle(utils::MiniFunction<Callback> const& fn, Ev* event) {
             if (event->getID() == m_id) {
                 return std::apply(fn, event->getArgs());
             }
             return ListenerResult::Propagate;
         }
 
+        std::optional<std::string_view> getRoutingKey() const {
+            return m_id;
+        }
+
         DispatchFilter(std::string const& id) : m_id(id) {}
         DispatchFilter(DispatchFilter const&) = default;
     };
@@ -4,8 +4,19 @@
 #include "../utils/MiniFunction.hpp"
 
 #include <Geode/DefaultInclude.hpp>
+#include <chrono>
+#include <compare>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
 #include <type_traits>
+#include <typeindex>
+#include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 namespace geode {
     class Mod;
@@ -19,6 +30,48 @@ namespace geode {
         Stop
     };
 
+    /**
+     * The type of event a listener handles, used by pools to only pass 
+     * events to listeners that can handle them
+     */
+    struct EventListenerType {
+        std::type_index type;
+        /**
+         * Check whether an event is of this type or derived from it. Null 
+         * means the listener accepts every event
+         */
+        bool (*matches)(Event*) = nullptr;
+        /**
+         * If set, the listener is only given events whose routing key is the 
+         * same (see Event::getRoutingKey)
+         */
+        std::optional<std::string> key = std::nullopt;
+    };
+
+    /**
+     * Counters for one type of event, collected by DefaultEventListenerPool 
+     * when the loader is built with GEODE_EVENT_STATS
+     */
+    struct EventStats {
+        struct Handler {
+            // the mod that created the listeners
+            Mod* mod;
+            size_t calls = 0;
+            // includes the time spent in events posted by the handlers
+            std::chrono::nanoseconds total {};
+            std::chrono::nanoseconds max {};
+        };
+
+        // the typeid name of the event
+        std::string type;
+        size_t posts = 0;
+        // listeners walked over, including ones removed mid-post
+        size_t visited = 0;
+        // listeners the event was given to
+        size_t handled = 0;
+        std::vector<Handler> handlers;
+    };
+
     struct GEODE_DLL EventListenerPool {
         virtual bool add(EventListenerProtocol* listener) = 0;
         virtual void remove(EventListenerProtocol* listener) = 0;
@@ -32,29 +85,116 @@ namespace geode {
     
     class GEODE_DLL DefaultEventListenerPool : public EventListenerPool {
     protected:
+        struct Order {
+            int priority;
+            // among listeners of the same priority, ones added later come first
+            size_t added;
+
+            auto operator<=>(Order const&) const = default;
+        };
+        // entries are stored lowest order first and walked backwards. a map 
+        // is used so adding is O(log n) (O(1) for the default priority, which 
+        // always goes at the end) and entries can be erased in O(1) through 
+        // the iterator kept for each listener
+        using Lane = std::map<Order, EventListenerProtocol*>;
+        struct Bucket;
+        struct Slot {
+            Lane* lane;
+            Lane::iterator entry;
+            Bucket* bucket;
+            // the hash of the routing key, if the lane is a keyed one
+            std::optional<size_t> key;
+        };
+        struct Bucket {
+            bool (*matches)(Event*) = nullptr;
+            // listeners without a routing key
+            Lane entries;
+            // listeners with a routing key, by the hash of the key. colliding 
+            // keys share a lane, which is fine since filters still check 
+            // the key themselves. lanes are dropped once they're empty, as 
+            // keys are often one-off (a node, a download)
+            std::unordered_map<size_t, Lane> keyed;
+        };
+
+        // events are mostly posted on the main thread, but some (like IPC 
+        // messages) are posted from others, and posting writes to the route 
+        // cache and flushes pending changes. recursive since listeners can 
+        // post events and add or remove listeners while being handed one
+        std::recursive_mutex m_mutex;
         std::atomic_size_t m_locked = 0;
-        std::vector<EventListenerProtocol*> m_listeners;
+        size_t m_nextAdded = 0;
+        // listeners grouped by the type of event they handle
+        std::unordered_map<std::type_index, Bucket> m_buckets;
+        std::unordered_map<EventListenerProtocol*, Slot> m_slots;
+        // which buckets each type of posted event reaches; cleared whenever 
+        // a bucket is added
+        std::unordered_map<std::type_index, std::vector<Bucket*>> m_routes;
+        // entries of listeners removed while handling an event; they're left 
+        // as null tombstones so iterators stay valid and erased afterwards
+        std::vector<Slot> m_tombstones;
         std::vector<EventListenerProtocol*> m_toAdd;
 
+        void insert(EventListenerProtocol* listener);
+        void erase(Slot const& slot);
+        std::vector<Bucket*> const& getRoute(Event* event);
+
     public:
         bool add(EventListenerProtocol* listener) override;
         void remove(EventListenerProtocol* listener) override;
         ListenerResult handle(Event* event) override;
 
         static DefaultEventListenerPool* get();
+
+        /**
+         * Whether the loader was built with GEODE_EVENT_STATS. If not, no 
+         * stats are collected and getStats always returns nothing
+         */
+        static bool hasStats();
+        /**
+         * Get a snapshot of the stats of every type of event posted to any 
+         * default pool since the stats were last reset
+         */
+        static std::vector<EventStats> getStats();
+        static void resetStats();
+        /**
+         * Log the stats, heaviest event types first
+         */
+        static void logStats();
     };
 
     class GEODE_DLL EventListenerProtocol {
     private:
         EventListenerPool* m_pool = nullptr;
+        int m_priority = 0;
+        Mod* m_owner = nullptr;
+
+    protected:
+        void setOwner(Mod* owner);
 
     public:
         bool enable();
         void disable();
 
+        /**
+         * Listeners with a higher priority are given events first. Listeners 
+         * with the same priority are given events newest first. Changing the 
+         * priority of an enabled listener re-adds it to its pool
+         */
+        void setPriority(int priority);
+        int getPriority() const;
+        /**
+         * The mod that created this listener, if known
+         */
+        Mod* getOwner() const;
+
         virtual EventListenerPool* getPool() const;
         virtual ListenerResult handle(Event*) = 0;
         virtual ~EventListenerProtocol();
+        /**
+         * Get the type of event this listener handles. Listeners that don't 
+         * override this are given every event
+         */
+        virtual EventListenerType getEventType() const;
     };
 
     template <typename C, typename T>
@@ -77,7 +217,12 @@ namespace geode {
         using Callback = ListenerResult(T*);
         using Event = T;
 
-        ListenerResult handle(utils::MiniFunction<Callback> fn, T* e) {
+        /**
+         * Filters should take the callback by const reference so delivering 
+         * an event doesn't copy it. Filters that take it by value still work, 
+         * but copy the callback on every event they receive
+         */
+        ListenerResult handle(utils::MiniFunction<Callback> const& fn, T* e) {
             return fn(e);
         }
 
@@ -121,26 +266,49 @@ namespace geode {
             return m_filter.getPool();
         }
 
-        EventListener(T filter = T()) : m_filter(filter) {
+        EventListenerType getEventType() const override {
+            EventListenerType type {
+                typeid(typename T::Event),
+                +[](Event* e) {
+                    return cast::typeinfo_cast<typename T::Event*>(e) != nullptr;
+                }
+            };
+            if constexpr (requires(T const& filter) { filter.getRoutingKey(); }) {
+                if (auto key = m_filter.getRoutingKey()) {
+                    type.key = std::string(*key);
+                }
+            }
+            return type;
+        }
+
+        EventListener(T filter = T(), int priority = 0) : m_filter(filter) {
             m_filter.setListener(this);
+            this->setOwner(getMod());
+            this->setPriority(priority);
             this->enable();
         }
 
-        EventListener(utils::MiniFunction<Callback> fn, T filter = T())
-          : m_callback(fn), m_filter(filter)
+        EventListener(utils::MiniFunction<Callback> fn, T filter = T(), int priority = 0)
+          : m_callback(std::move(fn)), m_filter(filter)
         {
             m_filter.setListener(this);
+            this->setOwner(getMod());
+            this->setPriority(priority);
             this->enable();
         }
 
-        EventListener(Callback* fnptr, T filter = T()) : m_callback(fnptr), m_filter(filter) {
+        EventListener(Callback* fnptr, T filter = T(), int priority = 0)
+          : m_callback(fnptr), m_filter(filter)
+        {
             m_filter.setListener(this);
+            this->setOwner(getMod());
+            this->setPriority(priority);
             this->enable();
         }
 
         template <class C>
-        EventListener(C* cls, MemberFn<C> fn, T filter = T()) :
-            EventListener(std::bind(fn, cls, std::placeholders::_1), filter)
+        EventListener(C* cls, MemberFn<C> fn, T filter = T(), int priority = 0) :
+            EventListener(bindMember(cls, fn), filter, priority)
         {
             m_filter.setListener(this);
             this->enable();
@@ -151,6 +319,8 @@ namespace geode {
             m_filter(std::move(other.m_filter))
         {
             m_filter.setListener(this);
+            this->setOwner(other.getOwner());
+            this->setPriority(other.getPriority());
             other.disable();
             this->enable();
         }
@@ -160,23 +330,35 @@ namespace geode {
             m_filter(other.m_filter)
         {
             m_filter.setListener(this);
+            this->setOwner(other.getOwner());
+            this->setPriority(other.getPriority());
             this->enable();
         }
 
         void bind(utils::MiniFunction<Callback> fn) {
-            m_callback = fn;
+            m_callback = std::move(fn);
         }
 
         template <typename C>
         void bind(C* cls, MemberFn<C> fn) {
-            m_callback = std::bind(fn, cls, std::placeholders::_1);
+            m_callback = bindMember(cls, fn);
         }
 
         void setFilter(T filter) {
             m_filter = filter;
             m_filter.setListener(this);
+            // the new filter may route to a different key
+            if constexpr (requires(T const& filter) { filter.getRoutingKey(); }) {
+                this->disable();
+                this->enable();
+            }
         }
 
+        /**
+         * The listener is routed by the filter's routing key when it's 
+         * enabled, so changing the key through this reference has no effect 
+         * on which events the listener is given. Use setFilter for that
+         */
         T& getFilter() {
             return m_filter;
         }
@@ -192,6 +374,13 @@ namespace geode {
     protected:
         utils::MiniFunction<Callback> m_callback = nullptr;
         T m_filter;
+
+        template <typename C>
+        static utils::MiniFunction<Callback> bindMember(C* cls, MemberFn<C> fn) {
+            return [cls, fn](auto&&... args) {
+                return (cls->*fn)(std::forward<decltype(args)>(args)...);
+            };
+        }
     };
 
     class GEODE_DLL [[nodiscard]] Event {
@@ -209,7 +398,31 @@ namespace geode {
         ListenerResult post() {
             return postFromMod(getMod());
         }
+
+        /**
+         * Post an event from any thread. The event is handed to listeners on 
+         * the main thread at the start of the next frame, in the same order 
+         * deferred events were posted in
+         * @param event The event to post
+         * @param coalesce If true, pending events of the same type and routing 
+         * key posted with coalesce are dropped in favor of this one, unless 
+         * another event with that key was posted in between. Meant for 
+         * progress updates where only the latest one matters
+         */
+        template <is_event T>
+        static void postDeferred(T event, bool coalesce = false) {
+            postDeferredFromMod(std::make_unique<T>(std::move(event)), getMod(), coalesce);
+        }
+        static void postDeferredFromMod(std::unique_ptr<Event> event, Mod* sender, bool coalesce = false);
         
         virtual ~Event();
+
+        /**
+         * Get the key listeners of this event are routed by, such as the ID 
+         * of a dispatch channel. Listeners whose filter declares a routing 
+         * key are only given events with the same key. Events without a key 
+         * are given to every listener
+         */
+        virtual std::optional<std::string_view> getRoutingKey() const;
     };
 }
@@ -45,6 +45,8 @@ namespace geode {
             json::Value& replyData
         );
         virtual ~IPCEvent();
+
+        std::optional<std::string_view> getRoutingKey() const override;
     };
 
     class GEODE_DLL IPCFilter : public EventFilter<IPCEvent> {
@@ -56,7 +58,8 @@ namespace geode {
         std::string m_messageID;
 
     public:
-        ListenerResult handle(utils::MiniFunction<Callback> fn, IPCEvent* event);
+        ListenerResult handle(utils::MiniFunction<Callback> const& fn, IPCEvent* event);
+        std::optional<std::string_view> getRoutingKey() const;
 		IPCFilter(
             std::string const& modID,
             std::string const& messageID
@@ -44,6 +44,8 @@ namespace geode {
          * The current status of the installation
          */
         const UpdateStatus status;
+
+        std::optional<std::string_view> getRoutingKey() const override;
     
     private:
         ModInstallEvent(std::string const& id, const UpdateStatus status);
@@ -73,7 +75,8 @@ namespace geode {
 	public:
 		using Callback = void(ModInstallEvent*);
 	
-        ListenerResult handle(utils::MiniFunction<Callback> fn, ModInstallEvent* event);
+        ListenerResult handle(utils::MiniFunction<Callback> const& fn, ModInstallEvent* event);
+        std::optional<std::string_view> getRoutingKey() const;
 		ModInstallFilter(std::string const& id);
         ModInstallFilter(ModInstallFilter const&) = default;
 	};
@@ -94,7 +97,7 @@ namespace geode {
     public:
         using Callback = void(IndexUpdateEvent*);
     
-        ListenerResult handle(utils::MiniFunction<Callback> fn, IndexUpdateEvent* event);
+        ListenerResult handle(utils::MiniFunction<Callback> const& fn, IndexUpdateEvent* event);
         IndexUpdateFilter();
         IndexUpdateFilter(IndexUpdateFilter const&) = default;
     };
@@ -125,6 +128,14 @@ namespace geode {
         std::unordered_set<std::string> getTags() const;
         bool isInstalled() const;
 
+        /**
+         * Copy-free versions of the getters above. The returned references 
+         * stay valid for as long as the item is alive
+         */
+        ModMetadata const& getMetadataRef() const;
+        std::unordered_set<PlatformID> const& getAvailablePlatformsRef() const;
+        std::unordered_set<std::string> const& getTagsRef() const;
+
 #if defined(GEODE_EXPOSE_SECRET_INTERNALS_IN_HEADERS_DO_NOT_DEFINE_PLEASE)
         void setMetadata(ModMetadata const& value);
         void setDownloadURL(std::string const& value);
@@ -10,11 +10,35 @@
 #include "Types.hpp"
 
 #include <atomic>
+#include <chrono>
+#include <memory>
 #include <mutex>
+#include <span>
 
 namespace geode {
     using ScheduledFunction = utils::MiniFunction<void()>;
 
+    /**
+     * Handle to a function scheduled with Loader::scheduleAfter or 
+     * Loader::scheduleEvery. Destroying the handle doesn't cancel the 
+     * function; call cancel for that
+     */
+    class GEODE_DLL TimerHandle {
+    private:
+        std::shared_ptr<std::atomic_bool> m_cancelled;
+
+    public:
+        TimerHandle() = default;
+        TimerHandle(std::shared_ptr<std::atomic_bool> cancelled);
+
+        /**
+         * Stop the function from running again. Safe to call from any thread, 
+         * and on handles that were already cancelled or never scheduled
+         */
+        void cancel();
+        bool isCancelled() const;
+    };
+
     struct InvalidGeodeFile {
         ghc::filesystem::path path;
         std::string reason;
@@ -32,7 +56,8 @@ namespace geode {
             LoadFailed,
             EnableFailed,
             MissingDependency,
-            PresentIncompatibility
+            PresentIncompatibility,
+            DependencyCycle
         };
         Type type;
         std::variant<ghc::filesystem::path, ModMetadata, Mod*> cause;
@@ -93,16 +118,95 @@ namespace geode {
         bool isModLoaded(std::string const& id) const;
         Mod* getLoadedMod(std::string const& id) const;
         std::vector<Mod*> getAllMods();
+        /**
+         * Get all mods without copying them. The view is only valid until 
+         * the mod list is refreshed
+         */
+        std::span<Mod* const> getAllModsView() const;
+        /**
+         * Get the amount of mods that are currently loaded
+         */
+        size_t getLoadedModCount() const;
+        /**
+         * Get the amount of mods that are currently enabled
+         */
+        size_t getEnabledModCount() const;
         [[deprecated("use Mod::get instead")]] Mod* getModImpl();
         [[deprecated]] void updateAllDependencies();
         [[deprecated("use getProblems instead")]] std::vector<InvalidGeodeFile> getFailedMods() const;
         std::vector<LoadProblem> getProblems() const;
+        /**
+         * Get all load problems without copying them. The view is only valid 
+         * until the mod graph is refreshed
+         */
+        std::span<LoadProblem const> getProblemsView() const;
+        /**
+         * Get the amount of load problems of a specific type
+         */
+        size_t getProblemCount(LoadProblem::Type type) const;
+        /**
+         * Check whether a mod has caused any load problems
+         * @param id The ID of the mod
+         */
+        bool hasProblems(std::string const& id) const;
+        /**
+         * Get the amount of load problems caused by a mod that are more 
+         * severe than a recommendation. Problems caused by a package with 
+         * the same ID that never became a mod aren't counted
+         * @param mod The mod
+         */
+        size_t getErrorCount(Mod* mod) const;
 
         void updateResources();
         void updateResources(bool forceReload);
 
         [[deprecated("use queueInMainThread instead")]] void queueInGDThread(ScheduledFunction func);
+        /**
+         * Run a function on the main thread during the next frame, or a later 
+         * one if the frame budget runs out. Functions queued by different 
+         * mods take turns, so one mod queueing a lot of work can't starve 
+         * the others
+         */
+        template <class F>
+            requires(std::is_invocable_v<F> && !std::is_same_v<std::decay_t<F>, ScheduledFunction>)
+        void queueInMainThread(F&& func) {
+            return this->queueInMainThreadFromMod(std::forward<F>(func), getMod());
+        }
+        /**
+         * Run a function that's already a ScheduledFunction on the main 
+         * thread. The mod that queued it isn't known, so it takes turns with 
+         * the other jobs that aren't attributed to a mod. Use 
+         * queueInMainThreadFromMod to attribute it
+         */
         void queueInMainThread(ScheduledFunction func);
+        void queueInMainThreadFromMod(ScheduledFunction func, Mod* mod);
+        /**
+         * Run a function on the main thread once the delay has passed. Timers 
+         * have a resolution of a millisecond, but are only checked once per 
+         * frame. Safe to call from any thread
+         * @returns Handle for cancelling the function
+         */
+        template <class = void>
+        TimerHandle scheduleAfter(std::chrono::milliseconds delay, ScheduledFunction func) {
+            return this->scheduleFromMod(delay, std::chrono::milliseconds(0), std::move(func), getMod());
+        }
+        /**
+         * Run a function on the main thread every time the interval passes, 
+         * until it's cancelled. Safe to call from any thread
+         * @returns Handle for cancelling the function
+         */
+        template <class = void>
+        TimerHandle scheduleEvery(std::chrono::milliseconds interval, ScheduledFunction func) {
+            return this->scheduleFromMod(interval, interval, std::move(func), getMod());
+        }
+        /**
+         * Schedule a function to run after a delay, and then every interval 
+         * if the interval isn't zero
+         */
+        TimerHandle scheduleFromMod(
+            std::chrono::milliseconds delay, std::chrono::milliseconds interval,
+            ScheduledFunction func, Mod* mod
+        );
         void waitForModsToBeLoaded();
 
         /**
@@ -7,8 +7,11 @@
 #include <Geode/utils/ranges.hpp>
 #include <ccTypes.h>
 #include <chrono>
+#include <fmt/format.h>
 #include <ghc/fs_fwd.hpp>
+#include <optional>
 #include <sstream>
+#include <string_view>
 #include <vector>
 #include <span>
 
@@ -137,6 +140,48 @@ namespace geode {
             }
         };
 
+        /**
+         * Argument of a log call, type-erased without allocating so that the 
+         * format string can be applied outside of the template
+         */
+        struct LogArg {
+            void const* value;
+            void (*append)(fmt::memory_buffer& out, void const* value);
+        };
+
+        template <class T>
+        void appendLogArg(fmt::memory_buffer& out, void const* value) {
+            auto const& item = *static_cast<T const*>(value);
+            // common types are formatted straight into the buffer instead of 
+            // going through a stringstream, with the same output as parse
+            if constexpr (
+                std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>
+            ) {
+                out.append(item.data(), item.data() + item.size());
+            }
+            else if constexpr (std::is_same_v<T, char const*> || std::is_same_v<T, char*>) {
+                if (item) {
+                    out.append(std::string_view(item));
+                }
+            }
+            else if constexpr (
+                std::is_integral_v<T> && !std::is_same_v<T, bool> && 
+                !std::is_same_v<T, char> && !std::is_same_v<T, signed char> && 
+                !std::is_same_v<T, unsigned char>
+            ) {
+                fmt::format_to(std::back_inserter(out), "{}", item);
+            }
+            else if constexpr (std::is_floating_point_v<T>) {
+                fmt::format_to(std::back_inserter(out), "{:g}", item);
+            }
+            else {
+                // on the stack rather than the heap, but still through 
+                // ComponentBase so specializations of it are respected
+                auto str = ComponentBase<T>(item)._toString();
+                out.append(str.data(), str.data() + str.size());
+            }
+        }
+
         // Log
 
         class GEODE_DLL Log final {
@@ -144,6 +189,7 @@ namespace geode {
             log_clock::time_point m_time;
             std::vector<ComponentTrait*> m_components;
             Severity m_severity;
+            std::string m_content;
 
             friend class Logger;
         public:
@@ -156,21 +202,68 @@ namespace geode {
             std::string toString(bool logTime = true) const;
             std::string toString(bool logTime, uint32_t nestLevel) const;
 
+            /**
+             * Components passed to addFormatNew. Logs made through the log 
+             * functions are formatted directly and have no components
+             */
             std::vector<ComponentTrait*>& getComponents();
             log_clock::time_point getTime() const;
             Mod* getSender() const;
             Severity getSeverity() const;
+            /**
+             * The formatted message, without the time and sender
+             */
+            std::string const& getContent() const;
 
             [[deprecated("Will be removed in next version")]]
             void addFormat(std::string_view formatStr, std::span<ComponentTrait*> comps);
 
             Result<> addFormatNew(std::string_view formatStr, std::span<ComponentTrait*> comps);
+            Result<> addFormatArgs(std::string_view formatStr, std::span<LogArg const> args);
+        };
+
+        struct LogQuery {
+            /**
+             * Only logs sent by this mod, or by anyone if null
+             */
+            Mod* mod = nullptr;
+            Severity minSeverity = Severity::Debug;
+            std::optional<log_clock::time_point> from;
+            std::optional<log_clock::time_point> until;
+            /**
+             * Only logs older than this position. Pass the next position of 
+             * the previous page to get the page after it
+             */
+            std::optional<uint64_t> before;
+            size_t limit = 100;
+        };
+
+        /**
+         * Copy of a log held in memory, taken when the logs were queried
+         */
+        struct LogEntry {
+            Mod* sender;
+            log_clock::time_point time;
+            Severity severity;
+            /**
+             * The formatted message, without the time and sender
+             */
+            std::string content;
+        };
+
+        struct LogPage {
+            /**
+             * Newest first
+             */
+            std::vector<LogEntry> logs;
+            /**
+             * Position to continue from for older logs, if there are any
+             */
+            std::optional<uint64_t> next;
         };
 
         class GEODE_DLL Logger {
         private:
-            static std::vector<Log>& logs();
-            static std::ofstream& logStream();
             static uint32_t& nestLevel();
 
             Logger() = delete;
@@ -180,13 +273,37 @@ namespace geode {
         public:
             static void setup();
 
+            /**
+             * Whether logs of this severity from this mod are kept. Checked 
+             * before anything about the log is built
+             */
+            static bool isEnabled(Severity severity, Mod* mod);
+            static void setMinimumSeverity(Severity severity);
+            static Severity getMinimumSeverity();
+            /**
+             * Set the minimum severity of the logs kept from one mod, 
+             * overriding the global minimum. Pass nullopt to go back to it
+             */
+            static void setMinimumSeverity(Mod* mod, std::optional<Severity> severity);
+            static std::optional<Severity> getMinimumSeverity(Mod* mod);
+
             static void push(Log&& log);
             static void pop(Log* log);
 
             static void pushNest();
             static void popNest();
 
+            /**
+             * Every log still kept in memory, oldest first. Only the most 
+             * recent logs are kept, so older ones may have been dropped. The 
+             * pointers are only valid until the next log is pushed; use 
+             * query() to get copies that outlive that
+             */
             static std::vector<Log*> list();
+            /**
+             * Find the logs kept in memory that match the query, newest first
+             */
+            static LogPage query(LogQuery const& query);
             static void clear();
         };
 
@@ -195,10 +312,14 @@ namespace geode {
                 (parse(b), ...);
             }
         void internalLog(Severity sev, Mod* m, std::string_view formatStr, Args... args) {
+            if (!Logger::isEnabled(sev, m)) {
+                return;
+            }
+
             Log l(m, sev);
 
-            std::array<ComponentTrait*, sizeof...(Args)> comps = { static_cast<ComponentTrait*>(new ComponentBase(args))... };
-            auto res = l.addFormatNew(formatStr, comps);
+            std::array<LogArg, sizeof...(Args)> logArgs = { LogArg { &args, &appendLogArg<Args> }... };
+            auto res = l.addFormatArgs(formatStr, logArgs);
 
             if (res.isErr()) {
                 internalLog(Severity::Warning, getMod(), "Error parsing log format \"{}\": {}", formatStr, res.unwrapErr());
@@ -208,24 +329,38 @@ namespace geode {
             Logger::push(std::move(l));
         }
 
+        // the severity is also checked here, before internalLog takes its 
+        // own copy of the arguments, so filtered calls don't copy anything
         template <typename... Args>
-        void debug(Args... args) {
-            internalLog(Severity::Debug, getMod(), args...);
+        void debug(Args const&... args) {
+            auto mod = getMod();
+            if (Logger::isEnabled(Severity::Debug, mod)) {
+                internalLog(Severity::Debug, mod, args...);
+            }
         }
 
         template <typename... Args>
-        void info(Args... args) {
-            internalLog(Severity::Info, getMod(), args...);
+        void info(Args const&... args) {
+            auto mod = getMod();
+            if (Logger::isEnabled(Severity::Info, mod)) {
+                internalLog(Severity::Info, mod, args...);
+            }
         }
 
         template <typename... Args>
-        void warn(Args... args) {
-            internalLog(Severity::Warning, getMod(), args...);
+        void warn(Args const&... args) {
+            auto mod = getMod();
+            if (Logger::isEnabled(Severity::Warning, mod)) {
+                internalLog(Severity::Warning, mod, args...);
+            }
         }
 
         template <typename... Args>
-        void error(Args... args) {
-            internalLog(Severity::Error, getMod(), args...);
+        void error(Args const&... args) {
+            auto mod = getMod();
+            if (Logger::isEnabled(Severity::Error, mod)) {
+                internalLog(Severity::Error, mod, args...);
+            }
         }
 
         static void pushNest() {
@@ -95,6 +95,14 @@ namespace geode {
         bool wasSuccessfullyLoaded() const;
         [[deprecated("use getMetadata instead")]] ModInfo getModInfo() const;
         ModMetadata getMetadata() const;
+        /**
+         * Copy-free versions of the getters above. The returned references 
+         * stay valid for the lifetime of the mod
+         */
+        std::string const& getIDRef() const;
+        std::string const& getNameRef() const;
+        std::string const& getDeveloperRef() const;
+        ModMetadata const& getMetadataRef() const;
         ghc::filesystem::path getTempDir() const;
         /**
          * Get the path to the mod's platform binary (.dll on Windows, .dylib 
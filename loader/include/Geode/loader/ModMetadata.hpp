@@ -169,6 +169,19 @@ namespace geode {
          */
         [[nodiscard]] bool isAPI() const;
 
+        /**
+         * Copy-free versions of the getters above. The returned references 
+         * stay valid until this ModMetadata is destroyed or modified
+         */
+        [[nodiscard]] std::string const& getIDRef() const;
+        [[nodiscard]] std::string const& getNameRef() const;
+        [[nodiscard]] std::string const& getDeveloperRef() const;
+        [[nodiscard]] std::optional<std::string> const& getDescriptionRef() const;
+        [[nodiscard]] std::optional<std::string> const& getDetailsRef() const;
+        [[nodiscard]] std::vector<Dependency> const& getDependenciesRef() const;
+        [[nodiscard]] std::vector<Incompatibility> const& getIncompatibilitiesRef() const;
+        [[nodiscard]] std::vector<std::pair<std::string, Setting>> const& getSettingsRef() const;
+
 #if defined(GEODE_EXPOSE_SECRET_INTERNALS_IN_HEADERS_DO_NOT_DEFINE_PLEASE)
         void setPath(ghc::filesystem::path const& value);
         void setBinaryName(std::string const& value);
@@ -231,6 +231,10 @@ namespace geode {
 
         std::string getKey() const;
         std::string getModID() const;
+        /**
+         * Copy-free version of getKey. Valid for the lifetime of the setting
+         */
+        std::string const& getKeyRef() const;
     };
 
     template<class T>
@@ -22,7 +22,7 @@ namespace geode {
     public:
         using Callback = void(SettingValue*);
 
-        ListenerResult handle(utils::MiniFunction<Callback> fn, SettingChangedEvent* event);
+        ListenerResult handle(utils::MiniFunction<Callback> const& fn, SettingChangedEvent* event);
         /**
          * Listen to changes on a setting, or all settings
          * @param modID Mod whose settings to listen to
@@ -43,10 +43,10 @@ namespace geode {
     public:
         using Callback = void(T);
 
-        ListenerResult handle(utils::MiniFunction<Callback> fn, SettingChangedEvent* event) {
+        ListenerResult handle(utils::MiniFunction<Callback> const& fn, SettingChangedEvent* event) {
             if (
-                m_modID == event->mod->getID() &&
-                (!m_targetKey || m_targetKey.value() == event->value->getKey())
+                m_modID == event->mod->getIDRef() &&
+                (!m_targetKey || m_targetKey.value() == event->value->getKeyRef())
             ) {
                 fn(SettingValueSetter<T>::get(event->value));
             }
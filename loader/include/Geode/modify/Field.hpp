@@ -40,7 +40,7 @@ namespace geode::modifier {
 
         void* setField(size_t index, size_t size, utils::MiniFunction<void(void*)> destructor) {
             m_containedFields.at(index) = operator new(size);
-            m_destructorFunctions.at(index) = destructor;
+            m_destructorFunctions.at(index) = std::move(destructor);
             return m_containedFields.at(index);
         }
 
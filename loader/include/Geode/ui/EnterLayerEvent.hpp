@@ -19,6 +19,8 @@ namespace geode {
             std::string const& layerID,
             cocos2d::CCNode* layer
         );
+
+        std::optional<std::string_view> getRoutingKey() const override;
     };
 
     class GEODE_DLL AEnterLayerFilter : public EventFilter<AEnterLayerEvent> {
@@ -29,7 +31,8 @@ namespace geode {
 		std::optional<std::string> m_targetID;
 	
 	public:
-        ListenerResult handle(utils::MiniFunction<Callback> fn, AEnterLayerEvent* event);
+        ListenerResult handle(utils::MiniFunction<Callback> const& fn, AEnterLayerEvent* event);
+        std::optional<std::string_view> getRoutingKey() const;
 
 		AEnterLayerFilter(
 			std::optional<std::string> const& id
@@ -62,13 +65,20 @@ namespace geode {
 		std::optional<std::string> m_targetID;
 	
 	public:
-        ListenerResult handle(utils::MiniFunction<Callback> fn, EnterLayerEvent<N>* event) {
+        ListenerResult handle(utils::MiniFunction<Callback> const& fn, EnterLayerEvent<N>* event) {
             if (m_targetID == event->getID()) {
                 fn(static_cast<T*>(event));
             }
 			return ListenerResult::Propagate;
 		}
 
+        std::optional<std::string_view> getRoutingKey() const {
+            if (m_targetID) {
+                return *m_targetID;
+            }
+            return std::nullopt;
+        }
+
 		EnterLayerFilter(
 			std::optional<std::string> const& id
 		) : m_targetID(id) {}
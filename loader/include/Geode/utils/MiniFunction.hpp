@@ -3,38 +3,81 @@
 #include <Geode/DefaultInclude.hpp>
 #include <memory>
 #include <concepts>
+#include <new>
+#include <type_traits>
 
 namespace geode::utils {
 
     template <class FunctionType>
     class MiniFunction;
 
+    template <class FunctionType>
+    class MoveMiniFunction;
+
     template <class Ret, class... Args>
     class MiniFunctionStateBase {
     public:
         virtual ~MiniFunctionStateBase() = default;
         virtual Ret call(Args... args) const = 0;
         virtual MiniFunctionStateBase* clone() const = 0;
+        // copy / move the state into the inline buffer of another function;
+        // only called on states that were small enough to be stored inline
+        virtual MiniFunctionStateBase* cloneInto(void* buffer) const = 0;
+        virtual MiniFunctionStateBase* moveInto(void* buffer) = 0;
+    };
+
+    template <class Derived, class Base>
+    class MiniFunctionStateImpl : public Base {
+    public:
+        Base* clone() const override {
+            // states of move-only callables are only ever held by a
+            // MoveMiniFunction, which never clones
+            if constexpr (std::is_copy_constructible_v<Derived>) {
+                return new Derived(static_cast<Derived const&>(*this));
+            }
+            else {
+                return nullptr;
+            }
+        }
+
+        Base* cloneInto(void* buffer) const override {
+            if constexpr (std::is_copy_constructible_v<Derived>) {
+                return new (buffer) Derived(static_cast<Derived const&>(*this));
+            }
+            else {
+                return nullptr;
+            }
+        }
+
+        Base* moveInto(void* buffer) override {
+            if constexpr (std::is_move_constructible_v<Derived>) {
+                return new (buffer) Derived(std::move(static_cast<Derived&>(*this)));
+            }
+            else {
+                return nullptr;
+            }
+        }
     };
 
     template <class Type, class Ret, class... Args>
-    class MiniFunctionState final : public MiniFunctionStateBase<Ret, Args...> {
+    class MiniFunctionState final : public MiniFunctionStateImpl<
+        MiniFunctionState<Type, Ret, Args...>, MiniFunctionStateBase<Ret, Args...>
+    > {
     public:
         Type m_func;
 
-        explicit MiniFunctionState(Type func) : m_func(func) {}
+        template <class Func>
+        explicit MiniFunctionState(Func&& func) : m_func(std::forward<Func>(func)) {}
 
         Ret call(Args... args) const override {
             return const_cast<Type&>(m_func)(args...);
         }
-
-        MiniFunctionStateBase<Ret, Args...>* clone() const override {
-            return new MiniFunctionState(*this);
-        }
     };
 
     template <class Type, class Ret, class... Args>
-    class MiniFunctionStatePointer final : public MiniFunctionStateBase<Ret, Args...> {
+    class MiniFunctionStatePointer final : public MiniFunctionStateImpl<
+        MiniFunctionStatePointer<Type, Ret, Args...>, MiniFunctionStateBase<Ret, Args...>
+    > {
     public:
         Type m_func;
 
@@ -43,28 +86,122 @@ namespace geode::utils {
         Ret call(Args... args) const override {
             return const_cast<Type&>(*m_func)(args...);
         }
-
-        MiniFunctionStateBase<Ret, Args...>* clone() const override {
-            return new MiniFunctionStatePointer(*this);
-        }
     };
 
     template <class Type, class Ret, class Class, class... Args>
-    class MiniFunctionStateMemberPointer final : public MiniFunctionStateBase<Ret, Class, Args...> {
+    class MiniFunctionStateMemberPointer final : public MiniFunctionStateImpl<
+        MiniFunctionStateMemberPointer<Type, Ret, Class, Args...>, MiniFunctionStateBase<Ret, Class, Args...>
+    > {
     public:
         Type m_func;
 
         explicit MiniFunctionStateMemberPointer(Type func) : m_func(func) {}
 
         Ret call(Class self, Args... args) const override {
-            return const_cast<Type&>(self->*m_func)(args...);
+            return (self->*m_func)(args...);
+        }
+    };
+
+    /**
+     * Owns the state of a MiniFunction. States small enough to fit (a vtable
+     * pointer plus captures of up to three pointers) are constructed inline
+     * instead of being heap allocated
+     */
+    template <class Ret, class... Args>
+    class MiniFunctionStorage final {
+    public:
+        using StateType = MiniFunctionStateBase<Ret, Args...>;
+
+        static constexpr size_t INLINE_SIZE = sizeof(void*) * 4;
+
+        template <class State>
+        static constexpr bool FITS_INLINE = sizeof(State) <= INLINE_SIZE &&
+            alignof(State) <= alignof(void*) && std::is_nothrow_move_constructible_v<State>;
+
+    private:
+        alignas(void*) unsigned char m_buffer[INLINE_SIZE];
+        StateType* m_state = nullptr;
+        bool m_inline = false;
+
+        void copyFrom(MiniFunctionStorage const& other) {
+            if (!other.m_state) return;
+            m_inline = other.m_inline;
+            m_state = m_inline ? other.m_state->cloneInto(m_buffer) : other.m_state->clone();
+        }
+
+        void moveFrom(MiniFunctionStorage& other) noexcept {
+            if (!other.m_state) return;
+            if (other.m_inline) {
+                m_state = other.m_state->moveInto(m_buffer);
+                m_inline = true;
+                other.reset();
+            }
+            else {
+                m_state = other.m_state;
+                other.m_state = nullptr;
+            }
+        }
+
+    public:
+        MiniFunctionStorage() = default;
+
+        MiniFunctionStorage(MiniFunctionStorage const& other) {
+            this->copyFrom(other);
+        }
+
+        MiniFunctionStorage(MiniFunctionStorage&& other) noexcept {
+            this->moveFrom(other);
+        }
+
+        ~MiniFunctionStorage() {
+            this->reset();
+        }
+
+        MiniFunctionStorage& operator=(MiniFunctionStorage const& other) {
+            if (this != &other) {
+                this->reset();
+                this->copyFrom(other);
+            }
+            return *this;
+        }
+
+        MiniFunctionStorage& operator=(MiniFunctionStorage&& other) noexcept {
+            if (this != &other) {
+                this->reset();
+                this->moveFrom(other);
+            }
+            return *this;
+        }
+
+        template <class State, class... StateArgs>
+        void emplace(StateArgs&&... args) {
+            this->reset();
+            if constexpr (FITS_INLINE<State>) {
+                m_state = new (m_buffer) State(std::forward<StateArgs>(args)...);
+                m_inline = true;
+            }
+            else {
+                m_state = new State(std::forward<StateArgs>(args)...);
+            }
         }
 
-        MiniFunctionStateBase<Ret, Class, Args...>* clone() const override {
-            return new MiniFunctionStateMemberPointer(*this);
+        void reset() noexcept {
+            if (!m_state) return;
+            if (m_inline) {
+                m_state->~StateType();
+            }
+            else {
+                delete m_state;
+            }
+            m_state = nullptr;
+            m_inline = false;
+        }
+
+        StateType* get() const {
+            return m_state;
         }
     };
-    
+
     template <class Callable, class Ret, class... Args>
     concept MiniFunctionCallable = requires(Callable&& func, Args... args) {
         { func(args...) } -> std::same_as<Ret>;
@@ -77,59 +214,123 @@ namespace geode::utils {
         using StateType = MiniFunctionStateBase<Ret, Args...>;
 
     private:
-        StateType* m_state;
+        MiniFunctionStorage<Ret, Args...> m_storage;
+
+        template <class>
+        friend class MoveMiniFunction;
 
     public:
-        MiniFunction() : m_state(nullptr) {}
+        MiniFunction() = default;
 
         MiniFunction(std::nullptr_t) : MiniFunction() {}
 
-        MiniFunction(MiniFunction const& other) :
-            m_state(other.m_state ? other.m_state->clone() : nullptr) {}
+        MiniFunction(MiniFunction const& other) = default;
+
+        MiniFunction(MiniFunction&& other) noexcept = default;
 
-        MiniFunction(MiniFunction&& other) : m_state(other.m_state) {
-            other.m_state = nullptr;
+        template <class Callable>
+        requires(
+            MiniFunctionCallable<Callable, Ret, Args...> &&
+            !std::is_same_v<std::decay_t<Callable>, MiniFunction<FunctionType>> &&
+            !std::is_same_v<std::decay_t<Callable>, MoveMiniFunction<FunctionType>> &&
+            std::is_copy_constructible_v<std::decay_t<Callable>>
+        )
+        MiniFunction(Callable&& func) {
+            m_storage.template emplace<MiniFunctionState<std::decay_t<Callable>, Ret, Args...>>(
+                std::forward<Callable>(func)
+            );
         }
 
-        ~MiniFunction() {
-            delete m_state;
+        template <class FunctionPointer>
+        requires(!MiniFunctionCallable<FunctionPointer, Ret, Args...> && std::is_pointer_v<FunctionPointer> && std::is_function_v<std::remove_pointer_t<FunctionPointer>>)
+        MiniFunction(FunctionPointer func) {
+            m_storage.template emplace<MiniFunctionStatePointer<FunctionPointer, Ret, Args...>>(func);
+        }
+
+        template <class MemberFunctionPointer>
+        requires(std::is_member_function_pointer_v<MemberFunctionPointer>)
+        MiniFunction(MemberFunctionPointer func) {
+            m_storage.template emplace<MiniFunctionStateMemberPointer<MemberFunctionPointer, Ret, Args...>>(func);
         }
 
+        MiniFunction& operator=(MiniFunction const& other) = default;
+
+        MiniFunction& operator=(MiniFunction&& other) noexcept = default;
+
+        Ret operator()(Args... args) const {
+            if (!m_storage.get()) return Ret();
+            return m_storage.get()->call(args...);
+        }
+
+        explicit operator bool() const {
+            return m_storage.get();
+        }
+    };
+
+    /**
+     * A MiniFunction that can't be copied. This lets it hold move-only
+     * callables (like lambdas capturing a unique_ptr) and means its state
+     * never has to be cloned, which makes it a better fit for one-shot jobs
+     * that are queued once and ran once
+     */
+    template <class Ret, class... Args>
+    class MoveMiniFunction<Ret(Args...)> {
+    public:
+        using FunctionType = Ret(Args...);
+        using StateType = MiniFunctionStateBase<Ret, Args...>;
+
+    private:
+        MiniFunctionStorage<Ret, Args...> m_storage;
+
+    public:
+        MoveMiniFunction() = default;
+
+        MoveMiniFunction(std::nullptr_t) : MoveMiniFunction() {}
+
+        MoveMiniFunction(MoveMiniFunction const& other) = delete;
+
+        MoveMiniFunction(MoveMiniFunction&& other) noexcept = default;
+
+        MoveMiniFunction(MiniFunction<FunctionType> const& other) : m_storage(other.m_storage) {}
+
+        MoveMiniFunction(MiniFunction<FunctionType>&& other) noexcept :
+            m_storage(std::move(other.m_storage)) {}
+
         template <class Callable>
-        requires(MiniFunctionCallable<Callable, Ret, Args...> && !std::is_same_v<std::decay_t<Callable>, MiniFunction<FunctionType>>)
-        MiniFunction(Callable&& func) :
-            m_state(new MiniFunctionState<std::decay_t<Callable>, Ret, Args...>(std::forward<Callable>(func))) {}
+        requires(
+            MiniFunctionCallable<Callable, Ret, Args...> &&
+            !std::is_same_v<std::decay_t<Callable>, MoveMiniFunction<FunctionType>> &&
+            !std::is_same_v<std::decay_t<Callable>, MiniFunction<FunctionType>>
+        )
+        MoveMiniFunction(Callable&& func) {
+            m_storage.template emplace<MiniFunctionState<std::decay_t<Callable>, Ret, Args...>>(
+                std::forward<Callable>(func)
+            );
+        }
 
-        template <class FunctionPointer> 
+        template <class FunctionPointer>
         requires(!MiniFunctionCallable<FunctionPointer, Ret, Args...> && std::is_pointer_v<FunctionPointer> && std::is_function_v<std::remove_pointer_t<FunctionPointer>>)
-        MiniFunction(FunctionPointer func) :
-            m_state(new MiniFunctionStatePointer<FunctionPointer, Ret, Args...>(func)) {}
+        MoveMiniFunction(FunctionPointer func) {
+            m_storage.template emplace<MiniFunctionStatePointer<FunctionPointer, Ret, Args...>>(func);
+        }
 
-        template <class MemberFunctionPointer> 
+        template <class MemberFunctionPointer>
         requires(std::is_member_function_pointer_v<MemberFunctionPointer>)
-        MiniFunction(MemberFunctionPointer func) :
-            m_state(new MiniFunctionStateMemberPointer<MemberFunctionPointer, Ret, Args...>(func)) {}
-
-        MiniFunction& operator=(MiniFunction const& other) {
-            delete m_state;
-            m_state = other.m_state ? other.m_state->clone() : nullptr;
-            return *this;
+        MoveMiniFunction(MemberFunctionPointer func) {
+            m_storage.template emplace<MiniFunctionStateMemberPointer<MemberFunctionPointer, Ret, Args...>>(func);
         }
 
-        MiniFunction& operator=(MiniFunction&& other) {
-            delete m_state;
-            m_state = other.m_state;
-            other.m_state = nullptr;
-            return *this;
-        }
+        MoveMiniFunction& operator=(MoveMiniFunction const& other) = delete;
+
+        MoveMiniFunction& operator=(MoveMiniFunction&& other) noexcept = default;
 
         Ret operator()(Args... args) const {
-            if (!m_state) return Ret();
-            return m_state->call(args...);
+            if (!m_storage.get()) return Ret();
+            return m_storage.get()->call(args...);
         }
 
         explicit operator bool() const {
-            return m_state;
+            return m_storage.get();
         }
     };
 }
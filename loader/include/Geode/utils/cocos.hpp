@@ -542,8 +542,10 @@ namespace geode {
             return nullptr;
         }
 
-        static EventListenerNode* create(typename Filter::Callback callback, Filter filter = Filter()) {
-            auto ret = new EventListenerNode(EventListener<Filter>(callback, filter));
+        static EventListenerNode* create(
+            typename Filter::Callback callback, Filter filter = Filter(), int priority = 0
+        ) {
+            auto ret = new EventListenerNode(EventListener<Filter>(callback, filter, priority));
             if (ret && ret->init()) {
                 ret->autorelease();
                 return ret;
@@ -270,7 +270,7 @@ namespace geode::utils::file {
     public:
         using Callback = void(FileWatchEvent*);
 
-        ListenerResult handle(utils::MiniFunction<Callback> callback, FileWatchEvent* event);
+        ListenerResult handle(utils::MiniFunction<Callback> const& callback, FileWatchEvent* event);
         FileWatchFilter(ghc::filesystem::path const& path);
     };
 
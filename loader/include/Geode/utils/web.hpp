@@ -336,7 +336,7 @@ namespace geode::utils::web {
     template <class T>
     AsyncWebRequest& AsyncWebResult<T>::then(utils::MiniFunction<void(T)> handle) {
         m_request.m_then = [converter = m_converter,
-                            handle](SentAsyncWebRequest& req, ByteVector const& arr) {
+                            handle = std::move(handle)](SentAsyncWebRequest& req, ByteVector const& arr) {
             auto conv = converter(arr);
             if (conv) {
                 handle(conv.unwrap());
@@ -351,7 +351,7 @@ namespace geode::utils::web {
     template <class T>
     AsyncWebRequest& AsyncWebResult<T>::then(utils::MiniFunction<void(SentAsyncWebRequest&, T)> handle) {
         m_request.m_then = [converter = m_converter,
-                            handle](SentAsyncWebRequest& req, ByteVector const& arr) {
+                            handle = std::move(handle)](SentAsyncWebRequest& req, ByteVector const& arr) {
             auto conv = converter(arr);
             if (conv) {
                 handle(req, conv.value());
@@ -170,13 +170,21 @@ void CCNode::updateLayout(bool updateChildOrder) {
 AttributeSetEvent::AttributeSetEvent(CCNode* node, std::string const& id, json::Value& value)
   : node(node), id(id), value(value) {}
 
-ListenerResult AttributeSetFilter::handle(MiniFunction<Callback> fn, AttributeSetEvent* event) {
+std::optional<std::string_view> AttributeSetEvent::getRoutingKey() const {
+    return id;
+}
+
+ListenerResult AttributeSetFilter::handle(MiniFunction<Callback> const& fn, AttributeSetEvent* event) {
     if (event->id == m_targetID) {
         fn(event);
     }
     return ListenerResult::Propagate;
 }
 
+std::optional<std::string_view> AttributeSetFilter::getRoutingKey() const {
+    return m_targetID;
+}
+
 AttributeSetFilter::AttributeSetFilter(std::string const& id) : m_targetID(id) {}
 
 void CCNode::setAttribute(std::string const& attr, json::Value const& value) {
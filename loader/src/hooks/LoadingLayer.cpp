@@ -10,15 +10,18 @@ using namespace geode::prelude;
 struct CustomLoadingLayer : Modify<CustomLoadingLayer, LoadingLayer> {
     CCLabelBMFont* m_loadedModsLabel;
     bool m_updatingResources;
+    bool m_waitingForMods;
+    TimerHandle m_labelTimer;
 
-    CustomLoadingLayer() : m_loadedModsLabel(nullptr), m_updatingResources(false) {}
+    CustomLoadingLayer() :
+        m_loadedModsLabel(nullptr), m_updatingResources(false), m_waitingForMods(false) {}
 
     void updateLoadedModsLabel() {
-        auto allMods = Loader::get()->getAllMods();
-        auto count = std::count_if(allMods.begin(), allMods.end(), [&](auto& item) {
-            return item->isLoaded();
-        });
-        auto str = fmt::format("Geode: Loaded {}/{} mods", count, allMods.size());
+        auto loader = Loader::get();
+        auto str = fmt::format(
+            "Geode: Loaded {}/{} mods",
+            loader->getLoadedModCount(), loader->getAllModsView().size()
+        );
         m_fields->m_loadedModsLabel->setCString(str.c_str());
     }
 
@@ -90,8 +93,21 @@ struct CustomLoadingLayer : Modify<CustomLoadingLayer, LoadingLayer> {
 
     void loadAssets() {
         if (Loader::get()->getLoadingState() != Loader::LoadingState::Done) {
+            if (m_fields->m_waitingForMods) {
+                return;
+            }
+            m_fields->m_waitingForMods = true;
             this->updateLoadedModsLabel();
-            Loader::get()->queueInMainThread([this]() {
+            // the label only needs to keep up with the eye, not every frame
+            m_fields->m_labelTimer = Loader::get()->scheduleEvery(
+                std::chrono::milliseconds(50), [this]() {
+                    this->updateLoadedModsLabel();
+                }
+            );
+            LoaderImpl::get()->onLoadingDone([this]() {
+                m_fields->m_labelTimer.cancel();
+                m_fields->m_waitingForMods = false;
+                this->updateLoadedModsLabel();
                 this->loadAssets();
             });
             return;
@@ -96,10 +96,10 @@ struct CustomMenuLayer : Modify<CustomMenuLayer, MenuLayer> {
         static bool shownFailedNotif = false;
         if (!shownFailedNotif) {
             shownFailedNotif = true;
-            auto problems = Loader::get()->getProblems();
-            if (std::any_of(problems.begin(), problems.end(), [&](auto& item) {
-                    return item.type != LoadProblem::Type::Suggestion && item.type != LoadProblem::Type::Recommendation;
-                })) {
+            auto loader = Loader::get();
+            if (loader->getProblemsView().size() >
+                loader->getProblemCount(LoadProblem::Type::Suggestion) +
+                loader->getProblemCount(LoadProblem::Type::Recommendation)) {
                 Notification::create("There were problems loading some mods", NotificationIcon::Error)->show();
             }
         }
@@ -1,4 +1,5 @@
 #include <loader/LoaderImpl.hpp>
+#include <loader/DeferredEventQueue.hpp>
 
 using namespace geode::prelude;
 
@@ -7,6 +8,7 @@ using namespace geode::prelude;
 struct FunctionQueue : Modify<FunctionQueue, CCScheduler> {
     void update(float dt) {
         LoaderImpl::get()->executeGDThreadQueue();
+        DeferredEventQueue::get()->drain();
         return CCScheduler::update(dt);
     }
 };
@@ -1,4 +1,5 @@
 #include "crashlog.hpp"
+#include <loader/LogSink.hpp>
 #include <fmt/core.h>
 
 using namespace geode::prelude;
@@ -18,12 +19,12 @@ static std::string getDateString(bool filesafe) {
 
 static void printGeodeInfo(std::stringstream& stream) {
     stream << "Loader Version: " << Loader::get()->getVersion().toString() << "\n"
-           << "Installed mods: " << Loader::get()->getAllMods().size() << "\n"
-           << "Problems: " << Loader::get()->getProblems().size() << "\n";
+           << "Installed mods: " << Loader::get()->getAllModsView().size() << "\n"
+           << "Problems: " << Loader::get()->getProblemsView().size() << "\n";
 }
 
 static void printMods(std::stringstream& stream) {
-    auto mods = Loader::get()->getAllMods();
+    auto mods = Loader::get()->getAllModsView();
     if (!mods.size()) {
         stream << "<None>\n";
     }
@@ -38,6 +39,10 @@ static void printMods(std::stringstream& stream) {
 }
 
 std::string crashlog::writeCrashlog(geode::Mod* faultyMod, std::string const& info, std::string const& stacktrace, std::string const& registers) {
+    // get everything logged up to the crash on disk, and write anything 
+    // logged from here on straight away
+    LogSink::get()->shutdown();
+
     // make sure crashlog directory exists
     (void)utils::file::createDirectoryAll(crashlog::getCrashLogDirectory());
 
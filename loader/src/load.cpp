@@ -1,4 +1,7 @@
 #include "loader/LoaderImpl.hpp"
+#include "loader/LogArchiver.hpp"
+#include "loader/LogRing.hpp"
+#include "loader/LogSink.hpp"
 
 #include <Geode/loader/IPC.hpp>
 #include <Geode/loader/Loader.hpp>
@@ -9,12 +12,56 @@
 #include <Geode/utils/JsonValidation.hpp>
 
 #include <array>
+#include <unordered_set>
 
 using namespace geode::prelude;
 
 #include "load.hpp"
 
+static void updateLogRotation() {
+    LogSink::get()->setRotation(
+        static_cast<size_t>(Mod::get()->getSettingValue<int64_t>("log-max-file-size")) * 1024 * 1024,
+        std::chrono::hours(Mod::get()->getSettingValue<int64_t>("log-max-file-age"))
+    );
+    LogArchiver::get()->setRetention(
+        static_cast<size_t>(Mod::get()->getSettingValue<int64_t>("log-retention-count")),
+        std::chrono::hours(Mod::get()->getSettingValue<int64_t>("log-retention-days") * 24)
+    );
+}
+
 $execute {
+    listenForSettingChanges("main-thread-frame-budget", +[](int64_t value) {
+        LoaderImpl::get()->m_mainThreadQueue.setBudget(std::chrono::milliseconds(value));
+    });
+
+    listenForSettingChanges("log-buffer-size", +[](int64_t value) {
+        LogRing::get()->setCapacity(static_cast<size_t>(value));
+    });
+
+    listenForSettingChanges("log-level", +[](std::string value) {
+        LoaderImpl::get()->applyLogLevels();
+    });
+
+    listenForSettingChanges("mod-log-levels", +[](std::string value) {
+        LoaderImpl::get()->applyLogLevels();
+    });
+
+    listenForSettingChanges("log-max-file-size", +[](int64_t value) {
+        updateLogRotation();
+    });
+
+    listenForSettingChanges("log-max-file-age", +[](int64_t value) {
+        updateLogRotation();
+    });
+
+    listenForSettingChanges("log-retention-count", +[](int64_t value) {
+        updateLogRotation();
+    });
+
+    listenForSettingChanges("log-retention-days", +[](int64_t value) {
+        updateLogRotation();
+    });
+
     listenForSettingChanges("show-platform-console", +[](bool value) {
         if (value) {
             Loader::get()->openPlatformConsole();
@@ -32,6 +79,150 @@ $execute {
         return Mod::get()->getMetadata();
     });
 
+    listenForIPC("loading-times", [](IPCEvent* event) -> json::Value {
+        return LoaderImpl::get()->getLoadingTimes();
+    });
+
+    listenForIPC("main-thread-queue", [](IPCEvent* event) -> json::Value {
+        return LoaderImpl::get()->m_mainThreadQueue.getStats();
+    });
+
+    listenForIPC("query-logs", [](IPCEvent* event) -> json::Value {
+        auto args = *event->messageData;
+        JsonChecker checker(args);
+        auto root = checker.root("").obj();
+
+        // this runs on the IPC thread, so the mods can only be looked up and 
+        // used while the registry is locked against the main thread
+        auto& registry = LoaderImpl::get()->m_mods;
+        auto lock = registry.lock();
+
+        log::LogQuery query;
+        if (auto id = root.has("mod")) {
+            query.mod = registry.get(id.template get<std::string>());
+            if (!query.mod) {
+                return json::Object();
+            }
+        }
+        if (auto severity = root.has("min-severity")) {
+            query.minSeverity = Severity::cast(severity.template get<int>());
+        }
+        if (auto before = root.has("before")) {
+            query.before = static_cast<uint64_t>(before.template get<double>());
+        }
+        if (auto limit = root.has("limit")) {
+            query.limit = static_cast<size_t>(limit.template get<int>());
+        }
+
+        auto page = log::Logger::query(query);
+        // logs outlive their sender if it was removed on a refresh
+        auto mods = registry.all();
+        std::unordered_set<Mod*> registered(mods.begin(), mods.end());
+
+        json::Value res = json::Object();
+        std::vector<json::Value> logs;
+        for (auto& log : page.logs) {
+            json::Value obj = json::Object();
+            obj["time"] = static_cast<double>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                log.time.time_since_epoch()
+            ).count());
+            obj["mod"] = registered.contains(log.sender) ? json::Value(log.sender->getID()) : json::Value();
+            obj["severity"] = Severity::toString(log.severity.m_value);
+            obj["content"] = log.content;
+            logs.push_back(obj);
+        }
+        res["logs"] = logs;
+        res["next"] = page.next ? json::Value(static_cast<double>(*page.next)) : json::Value();
+        return res;
+    });
+
+    listenForIPC("log-level", [](IPCEvent* event) -> json::Value {
+        auto args = *event->messageData;
+        JsonChecker checker(args);
+        auto root = checker.root("").obj();
+
+        // only the severities themselves are safe to touch from the IPC 
+        // thread; the mods are looked up under the registry lock
+        auto& registry = LoaderImpl::get()->m_mods;
+        auto lock = registry.lock();
+
+        Mod* mod = nullptr;
+        if (auto id = root.has("mod")) {
+            mod = registry.get(id.template get<std::string>());
+            if (!mod) {
+                return json::Object();
+            }
+        }
+        if (auto severity = root.has("severity")) {
+            auto parsed = LoaderImpl::parseSeverity(severity.template get<std::string>());
+            if (parsed && mod) {
+                log::Logger::setMinimumSeverity(mod, parsed);
+            }
+            else if (parsed) {
+                log::Logger::setMinimumSeverity(*parsed);
+            }
+        }
+        if (root.has("reset").template get<bool>() && mod) {
+            log::Logger::setMinimumSeverity(mod, std::nullopt);
+        }
+
+        json::Value res = json::Object();
+        res["default"] = Severity::toString(log::Logger::getMinimumSeverity().m_value);
+        json::Value mods = json::Object();
+        for (auto registered : registry.all()) {
+            if (auto severity = log::Logger::getMinimumSeverity(registered)) {
+                mods[registered->getID()] = Severity::toString(severity->m_value);
+            }
+        }
+        res["mods"] = mods;
+        return res;
+    });
+
+    listenForIPC("event-stats", [](IPCEvent* event) -> json::Value {
+        auto args = *event->messageData;
+        JsonChecker checker(args);
+        auto root = checker.root("").obj();
+
+        auto reset = root.has("reset").template get<bool>();
+        auto log = root.has("log").template get<bool>();
+
+        if (log) {
+            DefaultEventListenerPool::logStats();
+        }
+
+        json::Value res = json::Object();
+        res["enabled"] = DefaultEventListenerPool::hasStats();
+        std::vector<json::Value> types;
+        for (auto& stats : DefaultEventListenerPool::getStats()) {
+            json::Value type = json::Object();
+            type["type"] = stats.type;
+            type["posts"] = static_cast<double>(stats.posts);
+            type["visited"] = static_cast<double>(stats.visited);
+            type["handled"] = static_cast<double>(stats.handled);
+            std::vector<json::Value> handlers;
+            for (auto& handler : stats.handlers) {
+                json::Value obj = json::Object();
+                obj["mod"] = handler.mod ? json::Value(handler.mod->getID()) : json::Value();
+                obj["calls"] = static_cast<double>(handler.calls);
+                obj["total-us"] = static_cast<double>(
+                    std::chrono::duration_cast<std::chrono::microseconds>(handler.total).count()
+                );
+                obj["max-us"] = static_cast<double>(
+                    std::chrono::duration_cast<std::chrono::microseconds>(handler.max).count()
+                );
+                handlers.push_back(obj);
+            }
+            type["handlers"] = handlers;
+            types.push_back(type);
+        }
+        res["types"] = types;
+
+        if (reset) {
+            DefaultEventListenerPool::resetStats();
+        }
+        return res;
+    });
+
     listenForIPC("list-mods", [](IPCEvent* event) -> json::Value {
         std::vector<json::Value> res;
 
@@ -49,7 +240,8 @@ $execute {
             );
         }
 
-        for (auto& mod : Loader::get()->getAllMods()) {
+        auto lock = LoaderImpl::get()->m_mods.lock();
+        for (auto& mod : Loader::get()->getAllModsView()) {
             res.push_back(includeRunTimeInfo ? mod->getRuntimeInfo() : mod->getMetadata().toJSON());
         }
 
@@ -75,6 +267,16 @@ int geodeEntry(void* platformData) {
         Loader::get()->openPlatformConsole();
     }
 
+    LoaderImpl::get()->m_mainThreadQueue.setBudget(std::chrono::milliseconds(
+        Mod::get()->getSettingValue<int64_t>("main-thread-frame-budget")
+    ));
+    LogRing::get()->setCapacity(static_cast<size_t>(
+        Mod::get()->getSettingValue<int64_t>("log-buffer-size")
+    ));
+    LoaderImpl::get()->applyLogLevels();
+    // before setup, which opens the log file and cleans up old ones
+    updateLogRotation();
+
     // set up loader, load mods, etc.
     auto setupRes = LoaderImpl::get()->setup();
     if (!setupRes) {
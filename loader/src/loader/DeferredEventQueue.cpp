@@ -0,0 +1,64 @@
+#include "DeferredEventQueue.hpp"
+
+#include <optional>
+#include <set>
+#include <string_view>
+#include <typeindex>
+#include <vector>
+
+using namespace geode::prelude;
+
+void DeferredEventQueue::push(std::unique_ptr<Event> event, bool coalesce) {
+    auto node = new Node { std::move(event), coalesce, m_head.load(std::memory_order_relaxed) };
+    while (!m_head.compare_exchange_weak(
+        node->next, node, std::memory_order_release, std::memory_order_relaxed
+    ));
+}
+
+void DeferredEventQueue::drain() {
+    auto node = m_head.exchange(nullptr, std::memory_order_acquire);
+    if (!node) {
+        return;
+    }
+
+    // walk the list newest first so for every coalescing key the latest 
+    // event is seen first and older ones can be dropped
+    std::set<std::pair<std::type_index, std::optional<std::string_view>>> latest;
+    std::vector<std::unique_ptr<Node>> batch;
+    while (node) {
+        auto owned = std::unique_ptr<Node>(node);
+        node = node->next;
+
+        auto& event = *owned->event;
+        auto key = std::make_pair(std::type_index(typeid(event)), event.getRoutingKey());
+        if (owned->coalesce) {
+            if (!latest.insert(key).second) {
+                continue;
+            }
+        }
+        else {
+            // don't let coalescing move a newer event past this one
+            latest.erase(key);
+        }
+        batch.push_back(std::move(owned));
+    }
+
+    for (auto it = batch.rbegin(); it != batch.rend(); ++it) {
+        auto& event = (*it)->event;
+        event->postFromMod(event->sender);
+    }
+}
+
+DeferredEventQueue::~DeferredEventQueue() {
+    auto node = m_head.exchange(nullptr);
+    while (node) {
+        auto next = node->next;
+        delete node;
+        node = next;
+    }
+}
+
+DeferredEventQueue* DeferredEventQueue::get() {
+    static auto inst = new DeferredEventQueue();
+    return inst;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <Geode/loader/Event.hpp>
+#include <atomic>
+#include <memory>
+
+namespace geode {
+    /**
+     * Events posted with Event::postDeferred. Posting pushes onto a lock-free
+     * list so any thread can do it without blocking, and the main thread
+     * takes the whole list once per frame and hands the events to their pools
+     */
+    class DeferredEventQueue final {
+    private:
+        struct Node {
+            std::unique_ptr<Event> event;
+            bool coalesce;
+            Node* next;
+        };
+
+        // newest first
+        std::atomic<Node*> m_head = nullptr;
+
+    public:
+        void push(std::unique_ptr<Event> event, bool coalesce);
+        /**
+         * Post every pending event. Events posted while draining are left for
+         * the next drain. Must be called from the main thread
+         */
+        void drain();
+
+        ~DeferredEventQueue();
+
+        static DeferredEventQueue* get();
+    };
+}
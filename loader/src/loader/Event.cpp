@@ -1,47 +1,234 @@
 #include <Geode/loader/Event.hpp>
+#include "DeferredEventQueue.hpp"
+#include <Geode/loader/Log.hpp>
+#include <Geode/loader/Mod.hpp>
 #include <Geode/utils/ranges.hpp>
+#include <algorithm>
+#include <array>
+#include <iterator>
 #include <mutex>
+#include <span>
 
 using namespace geode::prelude;
 
+static size_t hashRoutingKey(std::string_view key) {
+    return std::hash<std::string_view>()(key);
+}
+
+#ifdef GEODE_EVENT_STATS
+// stats are written from handle on the main thread, but can be read and 
+// reset from elsewhere (like the IPC thread), so every access is locked. 
+// The lock is never held while a listener runs, since handlers can post 
+// events themselves. Entries are never erased, so handle can keep a 
+// reference to its entry between locks
+static std::mutex s_statsMutex;
+
+static std::unordered_map<std::type_index, EventStats>& getStatsByType() {
+    static std::unordered_map<std::type_index, EventStats> stats;
+    return stats;
+}
+
+static void addHandlerTime(EventStats& stats, Mod* mod, std::chrono::nanoseconds time) {
+    std::unique_lock lock(s_statsMutex);
+    auto handler = std::find_if(stats.handlers.begin(), stats.handlers.end(), [&](auto const& h) {
+        return h.mod == mod;
+    });
+    if (handler == stats.handlers.end()) {
+        handler = stats.handlers.insert(stats.handlers.end(), EventStats::Handler { mod });
+    }
+    handler->calls += 1;
+    handler->total += time;
+    handler->max = std::max(handler->max, time);
+}
+#endif
+
+void DefaultEventListenerPool::insert(EventListenerProtocol* listener) {
+    auto type = listener->getEventType();
+    auto [it, added] = m_buckets.try_emplace(type.type);
+    if (added) {
+        it->second.matches = type.matches;
+        // the new bucket may be reachable from event types already routed
+        m_routes.clear();
+    }
+    auto key = type.key ? std::optional(hashRoutingKey(*type.key)) : std::nullopt;
+    auto& lane = key ? it->second.keyed[*key] : it->second.entries;
+    auto entry = lane.emplace_hint(
+        lane.end(), Order { listener->getPriority(), m_nextAdded++ }, listener
+    );
+    m_slots[listener] = { &lane, entry, &it->second, key };
+}
+
+void DefaultEventListenerPool::erase(Slot const& slot) {
+    slot.lane->erase(slot.entry);
+    if (slot.key && slot.lane->empty()) {
+        slot.bucket->keyed.erase(*slot.key);
+    }
+}
+
+std::vector<DefaultEventListenerPool::Bucket*> const& DefaultEventListenerPool::getRoute(Event* event) {
+    auto type = std::type_index(typeid(*event));
+    auto it = m_routes.find(type);
+    if (it == m_routes.end()) {
+        std::vector<Bucket*> route;
+        for (auto& [_, bucket] : m_buckets) {
+            if (!bucket.matches || bucket.matches(event)) {
+                route.push_back(&bucket);
+            }
+        }
+        it = m_routes.insert({ type, std::move(route) }).first;
+    }
+    return it->second;
+}
+
 bool DefaultEventListenerPool::add(EventListenerProtocol* listener) {
+    std::unique_lock lock(m_mutex);
     if (m_locked) {
         m_toAdd.push_back(listener);
     }
     else {
-        // insert listeners at the start so new listeners get priority
-        m_listeners.insert(m_listeners.begin(), listener);
+        this->insert(listener);
     }
     return true;
 }
 
 void DefaultEventListenerPool::remove(EventListenerProtocol* listener) {
-    for (size_t i = 0; i < m_listeners.size(); i++) {
-        if (m_listeners[i] == listener) {
-            m_listeners[i] = nullptr;
-        }
-    }
+    std::unique_lock lock(m_mutex);
     ranges::remove(m_toAdd, listener);
+    auto it = m_slots.find(listener);
+    if (it == m_slots.end()) {
+        return;
+    }
+    auto slot = it->second;
+    m_slots.erase(it);
+    if (m_locked) {
+        // if an event listener gets destroyed in the middle of handling an 
+        // event, it gets set to null and cleaned up afterwards
+        slot.entry->second = nullptr;
+        m_tombstones.push_back(slot);
+    }
+    else {
+        this->erase(slot);
+    }
 }
 
 ListenerResult DefaultEventListenerPool::handle(Event* event) {
+    std::unique_lock lock(m_mutex);
     auto res = ListenerResult::Propagate;
     m_locked += 1;
-    for (auto h : m_listeners) {
-        // if an event listener gets destroyed in the middle of this loop, it 
-        // gets set to null
-        if (h && h->handle(event) == ListenerResult::Stop) {
-            res = ListenerResult::Stop;
-            break;
+
+#ifdef GEODE_EVENT_STATS
+    auto& stats = [&]() -> EventStats& {
+        std::unique_lock lock(s_statsMutex);
+        auto& stats = getStatsByType()[std::type_index(typeid(*event))];
+        stats.posts += 1;
+        return stats;
+    }();
+#endif
+
+    // give the event to a listener, returning whether it stopped propagation
+    auto deliver = [&](EventListenerProtocol* listener) {
+#ifdef GEODE_EVENT_STATS
+        {
+            std::unique_lock lock(s_statsMutex);
+            stats.visited += 1;
+            if (!listener) return false;
+            stats.handled += 1;
+        }
+        // the listener may be destroyed by its own handler
+        auto owner = listener->getOwner();
+        auto begin = std::chrono::steady_clock::now();
+        auto stop = listener->handle(event) == ListenerResult::Stop;
+        addHandlerTime(stats, owner, std::chrono::steady_clock::now() - begin);
+        return stop;
+#else
+        return listener && listener->handle(event) == ListenerResult::Stop;
+#endif
+    };
+
+    // collect the lanes this event can reach; almost every event reaches 
+    // only a few, so they're kept on the stack unless there are many
+    struct Cursor {
+        Lane* lane;
+        // one past the next entry to visit, as lanes are walked backwards
+        Lane::iterator next;
+    };
+    std::array<Cursor, 8> inlineCursors;
+    std::vector<Cursor> heapCursors;
+    size_t cursorCount = 0;
+    auto reach = [&](Lane& lane) {
+        if (lane.empty()) return;
+        if (cursorCount < inlineCursors.size()) {
+            inlineCursors[cursorCount] = { &lane, lane.end() };
+        }
+        else {
+            if (heapCursors.empty()) {
+                heapCursors.assign(inlineCursors.begin(), inlineCursors.end());
+            }
+            heapCursors.push_back({ &lane, lane.end() });
+        }
+        cursorCount += 1;
+    };
+
+    auto key = event->getRoutingKey();
+    auto keyHash = key ? hashRoutingKey(*key) : 0;
+    for (auto bucket : this->getRoute(event)) {
+        reach(bucket->entries);
+        if (key) {
+            auto lane = bucket->keyed.find(keyHash);
+            if (lane != bucket->keyed.end()) {
+                reach(lane->second);
+            }
+        }
+        else {
+            for (auto& [_, lane] : bucket->keyed) {
+                reach(lane);
+            }
         }
     }
+    auto cursors = cursorCount > inlineCursors.size() ?
+        std::span<Cursor>(heapCursors) :
+        std::span<Cursor>(inlineCursors.data(), cursorCount);
+
+    if (cursors.size() == 1) {
+        auto& entries = *cursors.front().lane;
+        for (auto it = entries.rbegin(); it != entries.rend(); ++it) {
+            auto h = it->second;
+            if (deliver(h)) {
+                res = ListenerResult::Stop;
+                break;
+            }
+        }
+    }
+    else if (cursors.size() > 1) {
+        // merge the lanes to keep the priority order across all of them
+        while (true) {
+            Cursor* first = nullptr;
+            for (auto& cursor : cursors) {
+                if (cursor.next == cursor.lane->begin()) continue;
+                if (!first || std::prev(cursor.next)->first > std::prev(first->next)->first) {
+                    first = &cursor;
+                }
+            }
+            if (!first) break;
+            first->next = std::prev(first->next);
+            auto h = first->next->second;
+            if (deliver(h)) {
+                res = ListenerResult::Stop;
+                break;
+            }
+        }
+    }
+
     m_locked -= 1;
     // only mutate listeners once nothing is iterating 
     // (if there are recursive handle calls)
     if (m_locked == 0) {
-        ranges::remove(m_listeners, nullptr);
+        for (auto& slot : m_tombstones) {
+            this->erase(slot);
+        }
+        m_tombstones.clear();
         for (auto listener : m_toAdd) {
-            m_listeners.insert(m_listeners.begin(), listener);
+            this->insert(listener);
         }
         m_toAdd.clear();
     }
@@ -53,6 +240,74 @@ DefaultEventListenerPool* DefaultEventListenerPool::get() {
     return inst;
 }
 
+bool DefaultEventListenerPool::hasStats() {
+#ifdef GEODE_EVENT_STATS
+    return true;
+#else
+    return false;
+#endif
+}
+
+std::vector<EventStats> DefaultEventListenerPool::getStats() {
+    std::vector<EventStats> res;
+#ifdef GEODE_EVENT_STATS
+    std::unique_lock lock(s_statsMutex);
+    for (auto& [type, stats] : getStatsByType()) {
+        if (!stats.posts) continue;
+        auto& copy = res.emplace_back(stats);
+        copy.type = type.name();
+    }
+#endif
+    return res;
+}
+
+void DefaultEventListenerPool::resetStats() {
+#ifdef GEODE_EVENT_STATS
+    std::unique_lock lock(s_statsMutex);
+    for (auto& [_, stats] : getStatsByType()) {
+        stats = EventStats();
+    }
+#endif
+}
+
+void DefaultEventListenerPool::logStats() {
+    if (!hasStats()) {
+        log::info("Event stats are not available in this build");
+        return;
+    }
+    auto totalTime = [](EventStats const& stats) {
+        std::chrono::nanoseconds total {};
+        for (auto& handler : stats.handlers) {
+            total += handler.total;
+        }
+        return total;
+    };
+    auto stats = getStats();
+    std::sort(stats.begin(), stats.end(), [&](auto const& a, auto const& b) {
+        return totalTime(a) > totalTime(b);
+    });
+    log::info("Event stats ({} types)", stats.size());
+    log::pushNest();
+    for (auto& type : stats) {
+        log::info(
+            "{}: {} posts, {} listeners visited, {} handled, {}us total",
+            type.type, type.posts, type.visited, type.handled,
+            std::chrono::duration_cast<std::chrono::microseconds>(totalTime(type)).count()
+        );
+        log::pushNest();
+        for (auto& handler : type.handlers) {
+            log::info(
+                "{}: {} calls, {}us total, {}us max",
+                handler.mod ? handler.mod->getID() : "<unknown>", handler.calls,
+                std::chrono::duration_cast<std::chrono::microseconds>(handler.total).count(),
+                std::chrono::duration_cast<std::chrono::microseconds>(handler.max).count()
+            );
+        }
+        log::popNest();
+    }
+    log::popNest();
+}
+
 EventListenerPool* EventListenerProtocol::getPool() const {
     return DefaultEventListenerPool::get();
 }
@@ -76,17 +331,53 @@ void EventListenerProtocol::disable() {
     }
 }
 
+void EventListenerProtocol::setPriority(int priority) {
+    if (m_priority == priority) {
+        return;
+    }
+    m_priority = priority;
+    if (m_pool) {
+        this->disable();
+        this->enable();
+    }
+}
+
+int EventListenerProtocol::getPriority() const {
+    return m_priority;
+}
+
+void EventListenerProtocol::setOwner(Mod* owner) {
+    m_owner = owner;
+}
+
+Mod* EventListenerProtocol::getOwner() const {
+    return m_owner;
+}
+
 EventListenerProtocol::~EventListenerProtocol() {
     this->disable();
 }
 
+EventListenerType EventListenerProtocol::getEventType() const {
+    return { typeid(Event), nullptr };
+}
+
 Event::~Event() {}
 
 EventListenerPool* Event::getPool() const {
     return DefaultEventListenerPool::get();
 }
 
+std::optional<std::string_view> Event::getRoutingKey() const {
+    return std::nullopt;
+}
+
 ListenerResult Event::postFromMod(Mod* m) {
     if (m) this->sender = m;
     return this->getPool()->handle(this);
 }
+
+void Event::postDeferredFromMod(std::unique_ptr<Event> event, Mod* m, bool coalesce) {
+    if (m) event->sender = m;
+    DeferredEventQueue::get()->push(std::move(event), coalesce);
+}
@@ -24,7 +24,11 @@ IPCEvent::IPCEvent(
 
 IPCEvent::~IPCEvent() {}
 
-ListenerResult IPCFilter::handle(utils::MiniFunction<Callback> fn, IPCEvent* event) {
+std::optional<std::string_view> IPCEvent::getRoutingKey() const {
+    return messageID;
+}
+
+ListenerResult IPCFilter::handle(utils::MiniFunction<Callback> const& fn, IPCEvent* event) {
     if (event->targetModID == m_modID && event->messageID == m_messageID) {
         event->replyData = fn(event);
         return ListenerResult::Stop;
@@ -32,5 +36,9 @@ ListenerResult IPCFilter::handle(utils::MiniFunction<Callback> fn, IPCEvent* eve
     return ListenerResult::Propagate;
 }
 
+std::optional<std::string_view> IPCFilter::getRoutingKey() const {
+    return m_messageID;
+}
+
 IPCFilter::IPCFilter(std::string const& modID, std::string const& messageID) :
     m_modID(modID), m_messageID(messageID) {}
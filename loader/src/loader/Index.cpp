@@ -20,13 +20,17 @@ ModInstallEvent::ModInstallEvent(
     std::string const& id, const UpdateStatus status
 ) : modID(id), status(status) {}
 
-ListenerResult ModInstallFilter::handle(utils::MiniFunction<Callback> fn, ModInstallEvent* event) {
+ListenerResult ModInstallFilter::handle(utils::MiniFunction<Callback> const& fn, ModInstallEvent* event) {
     if (m_id == event->modID) {
         fn(event);
     }
     return ListenerResult::Propagate;
 }
 
+std::optional<std::string_view> ModInstallFilter::getRoutingKey() const {
+    return m_id;
+}
+
 ModInstallFilter::ModInstallFilter(std::string const& id) : m_id(id) {}
 
 // IndexUpdateEvent
@@ -34,7 +38,7 @@ ModInstallFilter::ModInstallFilter(std::string const& id) : m_id(id) {}
 IndexUpdateEvent::IndexUpdateEvent(const UpdateStatus status) : status(status) {}
 
 ListenerResult IndexUpdateFilter::handle(
-    utils::MiniFunction<Callback> fn,
+    utils::MiniFunction<Callback> const& fn,
     IndexUpdateEvent* event
 ) {
     fn(event);
@@ -114,6 +118,18 @@ bool IndexItem::isInstalled() const {
     return m_impl->isInstalled();
 }
 
+ModMetadata const& IndexItem::getMetadataRef() const {
+    return m_impl->m_metadata;
+}
+
+std::unordered_set<PlatformID> const& IndexItem::getAvailablePlatformsRef() const {
+    return m_impl->m_platforms;
+}
+
+std::unordered_set<std::string> const& IndexItem::getTagsRef() const {
+    return m_impl->m_tags;
+}
+
 #if defined(GEODE_EXPOSE_SECRET_INTERNALS_IN_HEADERS_DO_NOT_DEFINE_PLEASE)
 void IndexItem::setMetadata(ModMetadata const& value) {
     m_impl->m_metadata = value;
@@ -191,10 +207,10 @@ bool IndexItem::Impl::isInstalled() const {
     if (m_isInstalled) {
         return true;
     }
-    if (!Loader::get()->isModInstalled(m_metadata.getID())) {
+    if (!Loader::get()->isModInstalled(m_metadata.getIDRef())) {
         return false;
     }
-    auto installed = Loader::get()->getInstalledMod(m_metadata.getID());
+    auto installed = Loader::get()->getInstalledMod(m_metadata.getIDRef());
     if (installed->getVersion() != m_metadata.getVersion()) {
         return false;
     }
@@ -457,9 +473,9 @@ void Index::update(bool force) {
 
 std::vector<IndexItemHandle> Index::getItems() const {
     std::vector<IndexItemHandle> res;
-    for (auto& items : map::values(m_impl->m_items)) {
-        for (auto& item : items) {
-            res.push_back(item.second);
+    for (auto& [_, items] : m_impl->m_items) {
+        for (auto& [_, item] : items) {
+            res.push_back(item);
         }
     }
     return res;
@@ -475,10 +491,10 @@ std::vector<IndexItemHandle> Index::getLatestItems() const {
 
 std::vector<IndexItemHandle> Index::getFeaturedItems() const {
     std::vector<IndexItemHandle> res;
-    for (auto& items : map::values(m_impl->m_items)) {
-        for (auto& item : items) {
-            if (item.second->isFeatured()) {
-                res.push_back(item.second);
+    for (auto& [_, items] : m_impl->m_items) {
+        for (auto& [_, item] : items) {
+            if (item->isFeatured()) {
+                res.push_back(item);
             }
         }
     }
@@ -489,10 +505,10 @@ std::vector<IndexItemHandle> Index::getItemsByDeveloper(
     std::string const& name
 ) const {
     std::vector<IndexItemHandle> res;
-    for (auto& items : map::values(m_impl->m_items)) {
-        for (auto& item : items) {
-            if (item.second->getMetadata().getDeveloper() == name) {
-                res.push_back(item.second);
+    for (auto& [_, items] : m_impl->m_items) {
+        for (auto& [_, item] : items) {
+            if (item->getMetadataRef().getDeveloperRef() == name) {
+                res.push_back(item);
             }
         }
     }
@@ -503,8 +519,9 @@ std::vector<IndexItemHandle> Index::getItemsByModID(
     std::string const& modID
 ) const {
     std::vector<IndexItemHandle> res;
-    if (m_impl->m_items.count(modID)) {
-        for (auto& [versionStr, item] : m_impl->m_items[modID]) {
+    auto it = m_impl->m_items.find(modID);
+    if (it != m_impl->m_items.end()) {
+        for (auto& [versionStr, item] : it->second) {
             res.push_back(item);
         }
     }
@@ -521,8 +538,9 @@ bool Index::isKnownItem(
 IndexItemHandle Index::getMajorItem(
     std::string const& id
 ) const {
-    if (m_impl->m_items.count(id)) {
-        return m_impl->m_items.at(id).rbegin()->second;
+    auto it = m_impl->m_items.find(id);
+    if (it != m_impl->m_items.end()) {
+        return it->second.rbegin()->second;
     }
     return nullptr;
 }
@@ -531,11 +549,11 @@ IndexItemHandle Index::getItem(
     std::string const& id,
     std::optional<VersionInfo> version
 ) const {
-    if (m_impl->m_items.count(id)) {
-        auto versions = m_impl->m_items.at(id);
+    auto it = m_impl->m_items.find(id);
+    if (it != m_impl->m_items.end()) {
         if (version) {
-            for (auto& [_, item] : ranges::reverse(m_impl->m_items.at(id))) {
-                if (version.value() == item->getMetadata().getVersion()) {
+            for (auto& [_, item] : ranges::reverse(it->second)) {
+                if (version.value() == item->getMetadataRef().getVersion()) {
                     return item;
                 }
             }
@@ -548,10 +566,11 @@ IndexItemHandle Index::getItem(
     std::string const& id,
     ComparableVersionInfo version
 ) const {
-    if (m_impl->m_items.count(id)) {
+    auto it = m_impl->m_items.find(id);
+    if (it != m_impl->m_items.end()) {
         // prefer most major version
-        for (auto& [_, item] : ranges::reverse(m_impl->m_items.at(id))) {
-            if (version.compare(item->getMetadata().getVersion())) {
+        for (auto& [_, item] : ranges::reverse(it->second)) {
+            if (version.compare(item->getMetadataRef().getVersion())) {
                 return item;
             }
         }
@@ -564,25 +583,25 @@ IndexItemHandle Index::getItem(ModInfo const& info) const {
 }
 
 IndexItemHandle Index::getItem(ModMetadata const& metadata) const {
-    return this->getItem(metadata.getID(), metadata.getVersion());
+    return this->getItem(metadata.getIDRef(), metadata.getVersion());
 }
 
 IndexItemHandle Index::getItem(Mod* mod) const {
-    return this->getItem(mod->getID(), mod->getVersion());
+    return this->getItem(mod->getIDRef(), mod->getVersion());
 }
 
 bool Index::isUpdateAvailable(IndexItemHandle item) const {
-    auto installed = Loader::get()->getInstalledMod(item->getMetadata().getID());
+    auto installed = Loader::get()->getInstalledMod(item->getMetadataRef().getIDRef());
     if (!installed) {
         return false;
     }
-    return item->getMetadata().getVersion() > installed->getVersion();
+    return item->getMetadataRef().getVersion() > installed->getVersion();
 }
 
 bool Index::areUpdatesAvailable() const {
-    for (auto& mod : Loader::get()->getAllMods()) {
-        auto item = this->getMajorItem(mod->getID());
-        if (item && item->getMetadata().getVersion() > mod->getVersion()) {
+    for (auto& mod : Loader::get()->getAllModsView()) {
+        auto item = this->getMajorItem(mod->getIDRef());
+        if (item && item->getMetadataRef().getVersion() > mod->getVersion()) {
             return true;
         }
     }
@@ -592,11 +611,11 @@ bool Index::areUpdatesAvailable() const {
 // Item installation
 
 Result<> Index::canInstall(IndexItemHandle item) const {
-    if (!item->getAvailablePlatforms().count(GEODE_PLATFORM_TARGET)) {
+    if (!item->getAvailablePlatformsRef().count(GEODE_PLATFORM_TARGET)) {
         return Err("Mod is not available on {}", GEODE_PLATFORM_NAME);
     }
 
-    for (auto& dep : item->getMetadata().getDependencies()) {
+    for (auto& dep : item->getMetadataRef().getDependenciesRef()) {
         // if the dep is resolved, then all its dependencies must be installed
         // already in order for that to have happened
         if (dep.isResolved()) continue;
@@ -605,7 +624,7 @@ Result<> Index::canInstall(IndexItemHandle item) const {
 
         // check if this dep is available in the index
         if (auto depItem = this->getItem(dep.id, dep.version)) {
-            if (!depItem->getAvailablePlatforms().count(GEODE_PLATFORM_TARGET)) {
+            if (!depItem->getAvailablePlatformsRef().count(GEODE_PLATFORM_TARGET)) {
                 return Err(
                     "Dependency {} is not available on {}",
                     dep.id, GEODE_PLATFORM_NAME
@@ -621,7 +640,7 @@ Result<> Index::canInstall(IndexItemHandle item) const {
                 "reason is that the version of the dependency this mod "
                 "depends on is not available. Please let the developer "
                 "of the mod ({}) know!",
-                dep.id, dep.version.toString(), item->getMetadata().getDeveloper()
+                dep.id, dep.version.toString(), item->getMetadataRef().getDeveloper()
             );
         }
     }
@@ -630,13 +649,13 @@ Result<> Index::canInstall(IndexItemHandle item) const {
 }
 
 Result<IndexInstallList> Index::getInstallList(IndexItemHandle item) const {
-    if (!item->getAvailablePlatforms().count(GEODE_PLATFORM_TARGET)) {
+    if (!item->getAvailablePlatformsRef().count(GEODE_PLATFORM_TARGET)) {
         return Err("Mod is not available on {}", GEODE_PLATFORM_NAME);
     }
 
     IndexInstallList list;
     list.target = item;
-    for (auto& dep : item->getMetadata().getDependencies()) {
+    for (auto& dep : item->getMetadataRef().getDependenciesRef()) {
         // if the dep is resolved, then all its dependencies must be installed
         // already in order for that to have happened
         if (dep.isResolved()) continue;
@@ -647,7 +666,7 @@ Result<IndexInstallList> Index::getInstallList(IndexItemHandle item) const {
 
         // check if this dep is available in the index
         if (auto depItem = this->getItem(dep.id, dep.version)) {
-            if (!depItem->getAvailablePlatforms().count(GEODE_PLATFORM_TARGET)) {
+            if (!depItem->getAvailablePlatformsRef().count(GEODE_PLATFORM_TARGET)) {
                 // it's fine to not install optional dependencies
                 if (dep.importance != ModMetadata::Dependency::Importance::Required) continue;
                 return Err(
@@ -668,7 +687,7 @@ Result<IndexInstallList> Index::getInstallList(IndexItemHandle item) const {
                 "reason is that the version of the dependency this mod "
                 "depends on is not available. Please let the developer "
                 "of the mod ({}) know!",
-                dep.id, dep.version.toString(), item->getMetadata().getDeveloper()
+                dep.id, dep.version.toString(), item->getMetadataRef().getDeveloper()
             );
         }
     }
@@ -678,9 +697,11 @@ Result<IndexInstallList> Index::getInstallList(IndexItemHandle item) const {
 }
 
 void Index::Impl::installNext(size_t index, IndexInstallList const& list) {
+    // install events are all deferred so they arrive in order with the 
+    // coalesced progress updates
     auto postError = [this, list](std::string const& error) {
         m_runningInstallations.erase(list.target);
-        ModInstallEvent(list.target->getMetadata().getID(), error).post();
+        Event::postDeferred(ModInstallEvent(list.target->getMetadataRef().getID(), error));
     };
 
     // If we're at the end of the list, move the downloaded items to mods
@@ -689,12 +710,12 @@ void Index::Impl::installNext(size_t index, IndexInstallList const& list) {
         // Move all downloaded files
         for (auto& item : list.list) {
             // If the mod is already installed, delete the old .geode file
-            if (auto mod = Loader::get()->getInstalledMod(item->getMetadata().getID())) {
+            if (auto mod = Loader::get()->getInstalledMod(item->getMetadataRef().getIDRef())) {
                 auto res = mod->uninstall();
                 if (!res) {
                     return postError(fmt::format(
                         "Unable to uninstall old version of {}: {}",
-                        item->getMetadata().getID(), res.unwrapErr()
+                        item->getMetadataRef().getID(), res.unwrapErr()
                     ));
                 }
             }
@@ -702,21 +723,20 @@ void Index::Impl::installNext(size_t index, IndexInstallList const& list) {
             // Move the temp file
             try {
                 ghc::filesystem::rename(
-                    dirs::getTempDir() / (item->getMetadata().getID() + ".index"),
-                    dirs::getModsDir() / (item->getMetadata().getID() + ".geode")
+                    dirs::getTempDir() / (item->getMetadataRef().getID() + ".index"),
+                    dirs::getModsDir() / (item->getMetadataRef().getID() + ".geode")
                 );
             } catch(std::exception& e) {
                 return postError(fmt::format(
                     "Unable to install {}: {}",
-                    item->getMetadata().getID(), e.what()
+                    item->getMetadataRef().getID(), e.what()
                 ));
             }
         }
 
-        auto const& eventModID = list.target->getMetadata().getID();
-        Loader::get()->queueInMainThread([eventModID]() {
-            ModInstallEvent(eventModID, UpdateFinished()).post();
-        });
+        Event::postDeferred(
+            ModInstallEvent(list.target->getMetadataRef().getID(), UpdateFinished())
+        );
 
         return;
     }
@@ -728,9 +748,9 @@ void Index::Impl::installNext(size_t index, IndexInstallList const& list) {
     };
 
     auto item = list.list.at(index);
-    auto tempFile = dirs::getTempDir() / (item->getMetadata().getID() + ".index");
+    auto tempFile = dirs::getTempDir() / (item->getMetadataRef().getID() + ".index");
     m_runningInstallations[list.target] = web::AsyncWebRequest()
-        .join("install_item_" + item->getMetadata().getID())
+        .join("install_item_" + item->getMetadataRef().getID())
         .fetch(item->getDownloadURL())
         .into(tempFile)
         .then([=](auto) {
@@ -740,25 +760,25 @@ void Index::Impl::installNext(size_t index, IndexInstallList const& list) {
                 return postError(fmt::format(
                     "Binary file download for {} returned \"404 Not found\". "
                     "Report this to the Geode development team.",
-                    item->getMetadata().getID()
+                    item->getMetadataRef().getID()
                 ));
             }
 
             // Verify checksum
-            ModInstallEvent(
-                list.target->getMetadata().getID(),
+            Event::postDeferred(ModInstallEvent(
+                list.target->getMetadataRef().getID(),
                 UpdateProgress(
                     scaledProgress(100),
-                    fmt::format("Verifying {}", item->getMetadata().getID())
+                    fmt::format("Verifying {}", item->getMetadataRef().getID())
                 )
-            ).post();
+            ), true);
 
             if (::calculateHash(tempFile) != item->getPackageHash()) {
                 return postError(fmt::format(
                     "Checksum mismatch with {}! (Downloaded file did not match what "
                     "was expected. Try again, and if the download fails another time, "
                     "report this to the Geode development team.)",
-                    item->getMetadata().getID()
+                    item->getMetadataRef().getID()
                 ));
             }
 
@@ -770,17 +790,17 @@ void Index::Impl::installNext(size_t index, IndexInstallList const& list) {
         .expect([postError, list, item](std::string const& err) {
             postError(fmt::format(
                 "Unable to download {}: {}",
-                item->getMetadata().getID(), err
+                item->getMetadataRef().getID(), err
             ));
         })
         .progress([this, item, list, scaledProgress](auto&, double now, double total) {
-            ModInstallEvent(
-                list.target->getMetadata().getID(),
+            Event::postDeferred(ModInstallEvent(
+                list.target->getMetadataRef().getID(),
                 UpdateProgress(
                     scaledProgress(now / total * 100.0),
-                    fmt::format("Downloading {}", item->getMetadata().getID())
+                    fmt::format("Downloading {}", item->getMetadataRef().getID())
                 )
-            ).post();
+            ), true);
         })
         .cancelled([postError](auto&) {
             postError("Download cancelled");
@@ -799,7 +819,7 @@ void Index::cancelInstall(IndexItemHandle item) {
 
 void Index::install(IndexInstallList const& list) {
     if (list.list.empty()) {
-        ModInstallEvent(list.target->getMetadata().getID(), UpdateFinished()).post();
+        ModInstallEvent(list.target->getMetadataRef().getID(), UpdateFinished()).post();
         return;
     }
     Loader::get()->queueInMainThread([this, list]() {
@@ -817,7 +837,7 @@ void Index::install(IndexItemHandle item) {
             this->install(list.unwrap());
         } else {
             ModInstallEvent(
-                item->getMetadata().getID(),
+                item->getMetadataRef().getID(),
                 UpdateFailed(list.unwrapErr())
             ).post();
         }
@@ -830,7 +850,7 @@ std::unordered_set<std::string> Index::getTags() const {
     std::unordered_set<std::string> tags;
     for (auto& [_, versions] : m_impl->m_items) {
         for (auto& [_, item] : versions) {
-            for (auto& tag : item->getTags()) {
+            for (auto& tag : item->getTagsRef()) {
                 tags.insert(tag);
             }
         }
@@ -0,0 +1,55 @@
+#include "LoadProblemStore.hpp"
+
+using namespace geode::prelude;
+
+static std::optional<std::string> getCauseID(LoadProblem const& problem) {
+    if (std::holds_alternative<ModMetadata>(problem.cause)) {
+        return std::get<ModMetadata>(problem.cause).getID();
+    }
+    if (std::holds_alternative<Mod*>(problem.cause)) {
+        return std::get<Mod*>(problem.cause)->getID();
+    }
+    return std::nullopt;
+}
+
+void LoadProblemStore::add(LoadProblem problem) {
+    m_byType[static_cast<size_t>(problem.type)] += 1;
+    if (auto id = getCauseID(problem)) {
+        m_byID[id.value()] += 1;
+    }
+    if (
+        std::holds_alternative<Mod*>(problem.cause) &&
+        problem.type > LoadProblem::Type::Recommendation
+    ) {
+        m_errorsByMod[std::get<Mod*>(problem.cause)] += 1;
+    }
+    m_problems.push_back(std::move(problem));
+}
+
+void LoadProblemStore::clear() {
+    m_problems.clear();
+    m_byID.clear();
+    m_errorsByMod.clear();
+    m_byType.fill(0);
+}
+
+std::span<LoadProblem const> LoadProblemStore::all() const {
+    return m_problems;
+}
+
+bool LoadProblemStore::empty() const {
+    return m_problems.empty();
+}
+
+size_t LoadProblemStore::countOfType(LoadProblem::Type type) const {
+    return m_byType[static_cast<size_t>(type)];
+}
+
+bool LoadProblemStore::has(std::string const& id) const {
+    return m_byID.contains(id);
+}
+
+size_t LoadProblemStore::countErrors(Mod* mod) const {
+    auto it = m_errorsByMod.find(mod);
+    return it != m_errorsByMod.end() ? it->second : 0;
+}
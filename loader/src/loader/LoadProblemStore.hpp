@@ -0,0 +1,45 @@
+#pragma once
+
+#include <Geode/loader/Loader.hpp>
+#include <array>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace geode {
+    /**
+     * Holds the problems found while loading mods, indexed by the mod that
+     * caused them and by problem type so that the common queries don't have
+     * to scan (or copy) the whole list
+     */
+    class LoadProblemStore final {
+    private:
+        static constexpr size_t TYPE_COUNT =
+            static_cast<size_t>(LoadProblem::Type::DependencyCycle) + 1;
+
+        std::vector<LoadProblem> m_problems;
+        std::unordered_map<std::string, size_t> m_byID;
+        std::unordered_map<Mod*, size_t> m_errorsByMod;
+        std::array<size_t, TYPE_COUNT> m_byType {};
+
+    public:
+        void add(LoadProblem problem);
+        void clear();
+
+        std::span<LoadProblem const> all() const;
+        bool empty() const;
+
+        size_t countOfType(LoadProblem::Type type) const;
+        /**
+         * Whether any problem was caused by the mod with this ID, including
+         * packages with that ID that never became a mod
+         */
+        bool has(std::string const& id) const;
+        /**
+         * Count the problems caused by this mod that are more severe than a
+         * recommendation
+         */
+        size_t countErrors(Mod* mod) const;
+    };
+}
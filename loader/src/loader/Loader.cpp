@@ -87,6 +87,18 @@ std::vector<Mod*> Loader::getAllMods() {
     return m_impl->getAllMods();
 }
 
+std::span<Mod* const> Loader::getAllModsView() const {
+    return m_impl->m_mods.all();
+}
+
+size_t Loader::getLoadedModCount() const {
+    return m_impl->m_mods.getLoadedCount();
+}
+
+size_t Loader::getEnabledModCount() const {
+    return m_impl->m_mods.getEnabledCount();
+}
+
 Mod* Loader::getModImpl() {
     return Mod::get();
 }
@@ -103,6 +115,22 @@ std::vector<LoadProblem> Loader::getProblems() const {
     return m_impl->getProblems();
 }
 
+std::span<LoadProblem const> Loader::getProblemsView() const {
+    return m_impl->m_problems.all();
+}
+
+size_t Loader::getProblemCount(LoadProblem::Type type) const {
+    return m_impl->m_problems.countOfType(type);
+}
+
+bool Loader::hasProblems(std::string const& id) const {
+    return m_impl->m_problems.has(id);
+}
+
+size_t Loader::getErrorCount(Mod* mod) const {
+    return m_impl->m_problems.countErrors(mod);
+}
+
 void Loader::updateResources() {
     return m_impl->updateResources();
 }
@@ -112,11 +140,22 @@ void Loader::updateResources(bool forceReload) {
 }
 
 void Loader::queueInGDThread(ScheduledFunction func) {
-    return m_impl->queueInMainThread(func);
+    return m_impl->queueInMainThread(std::move(func), nullptr);
 }
 
 void Loader::queueInMainThread(ScheduledFunction func) {
-    return m_impl->queueInMainThread(func);
+    return m_impl->queueInMainThread(std::move(func), nullptr);
+}
+
+void Loader::queueInMainThreadFromMod(ScheduledFunction func, Mod* mod) {
+    return m_impl->queueInMainThread(std::move(func), mod);
+}
+
+TimerHandle Loader::scheduleFromMod(
+    std::chrono::milliseconds delay, std::chrono::milliseconds interval,
+    ScheduledFunction func, Mod* mod
+) {
+    return m_impl->schedule(delay, interval, std::move(func), mod);
 }
 
 void Loader::waitForModsToBeLoaded() {
@@ -1,6 +1,7 @@
 #include "LoaderImpl.hpp"
 #include <cocos2d.h>
 
+#include "ModGraph.hpp"
 #include "ModImpl.hpp"
 #include "ModMetadataImpl.hpp"
 
@@ -16,6 +17,8 @@
 #include <Geode/utils/string.hpp>
 #include <Geode/utils/web.hpp>
 #include <about.hpp>
+#include <array>
+#include <chrono>
 #include <crashlog.hpp>
 #include <fmt/format.h>
 #include <hash.hpp>
@@ -41,9 +44,6 @@ void Loader::Impl::createDirectories() {
     ghc::filesystem::create_directory(dirs::getSaveDir());
 #endif
 
-    // try deleting geode/unzipped if it already exists
-    try { ghc::filesystem::remove_all(dirs::getModRuntimeDir()); } catch(...) {}
-
     (void) utils::file::createDirectoryAll(dirs::getGeodeResourcesDir());
     (void) utils::file::createDirectory(dirs::getModConfigDir());
     (void) utils::file::createDirectory(dirs::getModsDir());
@@ -109,7 +109,10 @@ void Loader::Impl::updateResources(bool forceReload) {
     log::debug("Adding resources");
 
     // add mods' spritesheets
-    for (auto const& [_, mod] : m_mods) {
+    for (auto mod : m_mods) {
+        // mods that haven't been extracted don't have any resources to add
+        if (ModImpl::getImpl(mod)->m_deferExtraction)
+            continue;
         if (forceReload || !ModImpl::getImpl(mod)->m_resourcesLoaded) {
             this->updateModResources(mod);
             ModImpl::getImpl(mod)->m_resourcesLoaded = true;
@@ -118,12 +121,13 @@ void Loader::Impl::updateResources(bool forceReload) {
 }
 
 std::vector<Mod*> Loader::Impl::getAllMods() {
-    return map::values(m_mods);
+    auto mods = m_mods.all();
+    return std::vector<Mod*>(mods.begin(), mods.end());
 }
 
 std::vector<InvalidGeodeFile> Loader::Impl::getFailedMods() const {
     std::vector<InvalidGeodeFile> inv;
-    for (auto const& item : this->getProblems()) {
+    for (auto const& item : m_problems.all()) {
         if (item.type != LoadProblem::Type::InvalidFile)
             continue;
         if (!holds_alternative<ghc::filesystem::path>(item.cause))
@@ -143,7 +147,9 @@ VersionInfo Loader::Impl::getVersion() {
 }
 
 VersionInfo Loader::Impl::minModVersion() {
-    return VersionInfo { 1, 0, 0, VersionTag(VersionTag::Beta, 5) };
+    // 1.4.0 broke the ABI of events, MiniFunction and logging, so mods 
+    // built against anything older crash instead of just misbehaving
+    return VersionInfo { 1, 4, 0 };
 }
 
 VersionInfo Loader::Impl::maxModVersion() {
@@ -165,7 +171,7 @@ bool Loader::Impl::isModVersionSupported(VersionInfo const& version) {
 
 Result<> Loader::Impl::saveData() {
     // save mods' data
-    for (auto& [id, mod] : m_mods) {
+    for (auto mod : m_mods) {
         auto r = mod->saveData();
         if (!r) {
             log::warn("Unable to save data for mod \"{}\": {}", mod->getID(), r.unwrapErr());
@@ -178,7 +184,7 @@ Result<> Loader::Impl::saveData() {
 }
 
 Result<> Loader::Impl::loadData() {
-    for (auto& [_, mod] : m_mods) {
+    for (auto mod : m_mods) {
         auto r = mod->loadData();
         if (!r) {
             log::warn("Unable to load data for mod \"{}\": {}", mod->getID(), r.unwrapErr());
@@ -190,26 +196,25 @@ Result<> Loader::Impl::loadData() {
 // Mod loading
 
 bool Loader::Impl::isModInstalled(std::string const& id) const {
-    return m_mods.count(id) && !m_mods.at(id)->isUninstalled();
+    return this->getInstalledMod(id) != nullptr;
 }
 
 Mod* Loader::Impl::getInstalledMod(std::string const& id) const {
-    if (m_mods.count(id) && !m_mods.at(id)->isUninstalled()) {
-        return m_mods.at(id);
+    auto mod = m_mods.get(id);
+    if (mod && !mod->isUninstalled()) {
+        return mod;
     }
     return nullptr;
 }
 
 bool Loader::Impl::isModLoaded(std::string const& id) const {
-    return m_mods.count(id) && m_mods.at(id)->isLoaded();
+    return this->getLoadedMod(id) != nullptr;
 }
 
 Mod* Loader::Impl::getLoadedMod(std::string const& id) const {
-    if (m_mods.count(id)) {
-        auto mod = m_mods.at(id);
-        if (mod->isLoaded()) {
-            return mod;
-        }
+    auto mod = m_mods.get(id);
+    if (mod && mod->isLoaded()) {
+        return mod;
     }
     return nullptr;
 }
@@ -272,76 +277,222 @@ void Loader::Impl::updateAllDependencies() {
     log::error("Called deprecated stub: Loader::updateAllDependencies");
 }
 
+// Runs the job for every index in [0, count) on a small worker pool and
+// returns the amount of threads used. The calling thread does its share of
+// the work too. A job that throws doesn't stop the others; the first error is
+// returned once every thread has finished
+static Result<size_t> parallelFor(size_t count, utils::MiniFunction<void(size_t)> const& job) {
+    std::atomic_size_t next = 0;
+    std::mutex errorMutex;
+    std::optional<std::string> error;
+    auto worker = [&]() {
+        for (size_t i; (i = next++) < count;) {
+            try {
+                job(i);
+            }
+            catch (std::exception& e) {
+                std::lock_guard lock(errorMutex);
+                if (!error) error = e.what();
+            }
+            catch (...) {
+                std::lock_guard lock(errorMutex);
+                if (!error) error = "Unknown exception";
+            }
+        }
+    };
+
+    auto threadCount = std::min<size_t>(
+        std::max(std::thread::hardware_concurrency(), 1u), count
+    );
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < threadCount; i++) {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : workers) {
+        thread.join();
+    }
+    if (error) {
+        return Err(std::move(error.value()));
+    }
+    return Ok(threadCount);
+}
+
 void Loader::Impl::queueMods(std::vector<ModMetadata>& modQueue) {
+    // collect every package up front in directory order, so that the results
+    // can be merged back in the same order regardless of which worker parsed
+    // them first
+    std::vector<ghc::filesystem::path> packages;
     for (auto const& dir : m_modSearchDirectories) {
         log::debug("Searching {}", dir);
-        log::pushNest();
         for (auto const& entry : ghc::filesystem::directory_iterator(dir)) {
             if (!ghc::filesystem::is_regular_file(entry) ||
                 entry.path().extension() != GEODE_MOD_EXTENSION)
                 continue;
+            packages.push_back(entry.path());
+        }
+    }
 
-            log::debug("Found {}", entry.path().filename());
-            log::pushNest();
+    // packages that haven't changed since the last launch are read from the
+    // metadata cache instead of being opened
+    m_metadataCache.load();
 
-            auto res = ModMetadata::createFromGeodeFile(entry.path());
-            if (!res) {
-                m_problems.push_back({
-                    LoadProblem::Type::InvalidFile,
-                    entry.path(),
-                    res.unwrapErr()
-                });
-                log::error("Failed to queue: {}", res.unwrapErr());
-                log::popNest();
-                continue;
-            }
-            auto modMetadata = res.unwrap();
-
-            log::debug("id: {}", modMetadata.getID());
-            log::debug("version: {}", modMetadata.getVersion());
-            log::debug("early: {}", modMetadata.needsEarlyLoad() ? "yes" : "no");
-
-            if (std::find_if(modQueue.begin(), modQueue.end(), [&](auto& item) {
-                    return modMetadata.getID() == item.getID();
-                }) != modQueue.end()) {
-                m_problems.push_back({
-                    LoadProblem::Type::Duplicate,
-                    modMetadata,
-                    "A mod with the same ID is already present."
-                });
-                log::error("Failed to queue: a mod with the same ID is already queued");
-                log::popNest();
-                continue;
-            }
+    // opening the zip and parsing mod.json is independent for every package,
+    // so fan it out over a small worker pool
+    std::vector<std::optional<Result<ModMetadata>>> results(packages.size());
+    std::vector<std::optional<file::Unzip>> handles(packages.size());
+    std::vector<uint8_t> fromCache(packages.size(), false);
+
+    auto begin = std::chrono::high_resolution_clock::now();
+
+    auto parallelRes = parallelFor(packages.size(), [&](size_t i) {
+        if (auto cached = m_metadataCache.get(packages[i])) {
+            results[i].emplace(Ok(std::move(cached.value())));
+            fromCache[i] = true;
+            return;
+        }
+        auto unzip = file::Unzip::create(packages[i]);
+        if (!unzip) {
+            results[i].emplace(Err(unzip.unwrapErr()));
+            return;
+        }
+        results[i] = ModMetadata::createFromGeodeZip(unzip.unwrap());
+        // keep the package open if it needs to be extracted anyway
+        if (results[i].value() && ModImpl::isTempDirStale(results[i].value().unwrap())) {
+            handles[i].emplace(std::move(unzip.unwrap()));
+        }
+    });
+
+    auto end = std::chrono::high_resolution_clock::now();
+    auto time = std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count();
+    if (!parallelRes) {
+        log::error("Reading packages failed: {}", parallelRes.unwrapErr());
+    }
+    log::debug(
+        "Read {} packages on {} threads in {}s",
+        packages.size(), parallelRes.unwrapOr(1), static_cast<float>(time) / 1000.f
+    );
+    log::debug(
+        "Metadata cache: {} hits, {} misses",
+        m_metadataCache.getHits(), m_metadataCache.getMisses()
+    );
+
+    for (size_t i = 0; i < packages.size(); i++) {
+        auto const& path = packages[i];
+        if (!results[i]) {
+            results[i].emplace(Err(parallelRes.unwrapErr()));
+        }
+        auto& res = results[i].value();
 
-            modQueue.push_back(modMetadata);
+        log::debug("Found {}", path.filename());
+        log::pushNest();
+
+        if (!res) {
+            m_problems.add({
+                LoadProblem::Type::InvalidFile,
+                path,
+                res.unwrapErr()
+            });
+            log::error("Failed to queue: {}", res.unwrapErr());
+            log::popNest();
+            continue;
+        }
+        auto modMetadata = std::move(res.unwrap());
+
+        if (!fromCache[i]) {
+            m_metadataCache.store(modMetadata);
+        }
+
+        log::debug("id: {}", modMetadata.getID());
+        log::debug("version: {}", modMetadata.getVersion());
+        log::debug("early: {}", modMetadata.needsEarlyLoad() ? "yes" : "no");
+
+        if (std::find_if(modQueue.begin(), modQueue.end(), [&](auto& item) {
+                return modMetadata.getID() == item.getID();
+            }) != modQueue.end()) {
+            m_problems.add({
+                LoadProblem::Type::Duplicate,
+                modMetadata,
+                "A mod with the same ID is already present."
+            });
+            log::error("Failed to queue: a mod with the same ID is already queued");
             log::popNest();
+            continue;
+        }
+
+        if (handles[i]) {
+            m_packageHandles.emplace(path.string(), std::move(handles[i].value()));
         }
+
+        modQueue.push_back(std::move(modMetadata));
         log::popNest();
     }
+
+    m_metadataCache.retain(packages);
+    auto saveRes = m_metadataCache.save();
+    if (!saveRes) {
+        log::warn("Unable to save mod metadata cache: {}", saveRes.unwrapErr());
+    }
 }
 
 void Loader::Impl::populateModList(std::vector<ModMetadata>& modQueue) {
-    std::vector<std::string> toRemove;
-    for (auto& [id, mod] : m_mods) {
-        if (id == "geode.loader")
+    std::vector<Mod*> toRemove;
+    for (auto mod : m_mods) {
+        if (mod->getID() == "geode.loader")
             continue;
-        delete mod;
-        toRemove.push_back(id);
+        toRemove.push_back(mod);
     }
-    for (auto const& id : toRemove) {
-        m_mods.erase(id);
+    for (auto mod : toRemove) {
+        m_mods.remove(mod);
+        delete mod;
     }
 
+    std::vector<Mod*> mods;
     for (auto const& metadata : modQueue) {
-        log::debug("{} {}", metadata.getID(), metadata.getVersion());
-        log::pushNest();
-
         auto mod = new Mod(metadata);
+        // disabled mods aren't extracted until they're actually loaded
+        mod->m_impl->m_deferExtraction =
+            !Mod::get()->getSavedValue<bool>("should-load-" + metadata.getID(), true);
+        mods.push_back(mod);
+    }
+
+    // extracting packages is the most expensive part of setting mods up, so
+    // it's done on a worker pool up front
+    auto begin = std::chrono::high_resolution_clock::now();
+
+    std::vector<std::optional<Result<>>> extracted(mods.size());
+    auto parallelRes = parallelFor(mods.size(), [&](size_t i) {
+        auto handle = m_packageHandles.find(mods[i]->getPackagePath().string());
+        extracted[i] = mods[i]->m_impl->createTempDir(
+            handle != m_packageHandles.end() ? &handle->second : nullptr
+        );
+    });
+    m_packageHandles.clear();
+
+    auto end = std::chrono::high_resolution_clock::now();
+    auto time = std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count();
+    if (!parallelRes) {
+        log::error("Preparing runtime directories failed: {}", parallelRes.unwrapErr());
+    }
+    log::debug(
+        "Prepared {} runtime directories on {} threads in {}s",
+        mods.size(), parallelRes.unwrapOr(1), static_cast<float>(time) / 1000.f
+    );
+
+    for (size_t i = 0; i < mods.size(); i++) {
+        auto mod = mods[i];
+        log::debug("{} {}", mod->getID(), mod->getVersion());
+        log::pushNest();
 
-        auto res = mod->m_impl->setup();
+        if (!extracted[i]) {
+            extracted[i].emplace(Err(parallelRes.unwrapErr()));
+        }
+        auto res = extracted[i].value().expect("Unable to create temp dir: {error}");
+        if (res) {
+            res = mod->m_impl->setup();
+        }
         if (!res) {
-            m_problems.push_back({
+            m_problems.add({
                 LoadProblem::Type::SetupFailed,
                 mod,
                 res.unwrapErr()
@@ -351,25 +502,41 @@ void Loader::Impl::populateModList(std::vector<ModMetadata>& modQueue) {
             continue;
         }
 
-        m_mods.insert({metadata.getID(), mod});
+        m_mods.add(mod);
 
         log::popNest();
     }
+
+    this->cleanModRuntimeDir();
+}
+
+void Loader::Impl::cleanModRuntimeDir() {
+    // extracted packages are kept across launches, so remove the ones whose
+    // mod is no longer installed
+    std::vector<ghc::filesystem::path> unused;
+    std::error_code ec;
+    for (auto const& entry : ghc::filesystem::directory_iterator(dirs::getModRuntimeDir(), ec)) {
+        if (entry.is_directory() && !m_mods.contains(entry.path().filename().string())) {
+            unused.push_back(entry.path());
+        }
+    }
+    for (auto const& dir : unused) {
+        log::debug("Removing unused runtime directory {}", dir.filename());
+        ghc::filesystem::remove_all(dir, ec);
+    }
 }
 
 void Loader::Impl::buildModGraph() {
-    for (auto const& [id, mod] : m_mods) {
+    for (auto mod : m_mods) {
         log::debug("{}", mod->getID());
         log::pushNest();
         for (auto& dependency : mod->m_impl->m_metadata.m_impl->m_dependencies) {
             log::debug("{}", dependency.id);
-            if (!m_mods.contains(dependency.id)) {
-                dependency.mod = nullptr;
+            dependency.mod = m_mods.get(dependency.id);
+            if (!dependency.mod) {
                 continue;
             }
 
-            dependency.mod = m_mods[dependency.id];
-
             if (!dependency.version.compare(dependency.mod->getVersion())) {
                 dependency.mod = nullptr;
                 continue;
@@ -381,14 +548,85 @@ void Loader::Impl::buildModGraph() {
             dependency.mod->m_impl->m_dependants.push_back(mod);
         }
         for (auto& incompatibility : mod->m_impl->m_metadata.m_impl->m_incompatibilities) {
-            incompatibility.mod =
-                m_mods.contains(incompatibility.id) ? m_mods[incompatibility.id] : nullptr;
+            incompatibility.mod = m_mods.get(incompatibility.id);
         }
         log::popNest();
     }
+
+    this->sortModGraph();
+}
+
+void Loader::Impl::sortModGraph() {
+    auto mods = m_mods.all();
+    auto sorted = mod_graph::sort(mods, [](Mod* mod, auto&& visit) {
+        for (auto dependant : mod->m_impl->m_dependants) {
+            visit(dependant);
+        }
+    });
+    m_loadOrder = std::move(sorted.order);
+
+    // whether mods need to be loaded early propagates from dependants to 
+    // their dependencies, so walk the order backwards
+    for (auto it = m_loadOrder.rbegin(); it != m_loadOrder.rend(); ++it) {
+        auto impl = (*it)->m_impl.get();
+        impl->m_needsEarlyLoad = impl->m_metadata.needsEarlyLoad() ||
+            std::any_of(impl->m_dependants.begin(), impl->m_dependants.end(), [](auto& item) {
+                return item->m_impl->m_needsEarlyLoad;
+            });
+    }
+
+    if (sorted.blocked.empty()) {
+        return;
+    }
+
+    // every mod left is either part of a cycle or depends on one. split them 
+    // into strongly connected components so that only the mods that are 
+    // actually part of a cycle get reported as such; the ones that merely 
+    // depend on a cycle are reported as missing a dependency later on
+    auto isRequiredEdge = [&](ModMetadata::Dependency const& dep) {
+        return dep.importance == ModMetadata::Dependency::Importance::Required &&
+            dep.mod && sorted.blocked.contains(dep.mod);
+    };
+    std::vector<Mod*> blocked;
+    for (auto mod : mods) {
+        if (sorted.blocked.contains(mod)) {
+            blocked.push_back(mod);
+        }
+    }
+    auto component = mod_graph::components<Mod*>(blocked, [&](Mod* mod, auto&& visit) {
+        for (auto const& dep : mod->m_impl->m_metadata.m_impl->m_dependencies) {
+            if (isRequiredEdge(dep)) {
+                visit(dep.mod);
+            }
+        }
+    });
+
+    for (auto mod : blocked) {
+        // a mod is part of a cycle exactly when it requires another member 
+        // of its own component (or itself)
+        std::string cycle;
+        for (auto const& dep : mod->m_impl->m_metadata.m_impl->m_dependencies) {
+            if (isRequiredEdge(dep) && component[dep.mod] == component[mod]) {
+                cycle += (cycle.empty() ? "" : ", ") + dep.id;
+            }
+        }
+        if (cycle.empty())
+            continue;
+        m_problems.add({
+            LoadProblem::Type::DependencyCycle,
+            mod,
+            fmt::format("Circular dependency through {}", cycle)
+        });
+        log::error("{} is part of a dependency cycle through {}", mod->getID(), cycle);
+    }
 }
 
 void Loader::Impl::loadModGraph(Mod* node, bool early) {
+    // mods are visited in load order, so by the time a mod is reached all of 
+    // its dependencies have already had their chance to load
+    if (node->isLoaded())
+        return;
+
     if (early && !node->needsEarlyLoad()) {
         m_modsToLoad.push(node);
         return;
@@ -402,30 +640,16 @@ void Loader::Impl::loadModGraph(Mod* node, bool early) {
     log::debug("{} {}", node->getID(), node->getVersion());
     log::pushNest();
 
-    if (node->isLoaded()) {
-        for (auto const& dep : node->m_impl->m_dependants) {
-            this->loadModGraph(dep, early);
-        }
-        log::popNest();
-        return;
-    }
-
     if (Mod::get()->getSavedValue<bool>("should-load-" + node->getID(), true)) {
         log::debug("Load");
         auto res = node->m_impl->loadBinary();
         if (!res) {
-            m_problems.push_back({
+            m_problems.add({
                 LoadProblem::Type::LoadFailed,
                 node,
                 res.unwrapErr()
             });
             log::error("Failed to load binary: {}", res.unwrapErr());
-            log::popNest();
-            return;
-        }
-
-        for (auto const& dep : node->m_impl->m_dependants) {
-            this->loadModGraph(dep, early);
         }
     }
 
@@ -433,8 +657,8 @@ void Loader::Impl::loadModGraph(Mod* node, bool early) {
 }
 
 void Loader::Impl::findProblems() {
-    for (auto const& [id, mod] : m_mods) {
-        log::debug(id);
+    for (auto mod : m_mods) {
+        log::debug("{}", mod->getID());
         log::pushNest();
 
         for (auto const& dep : mod->getMetadata().getDependencies()) {
@@ -442,28 +666,28 @@ void Loader::Impl::findProblems() {
                 continue;
             switch(dep.importance) {
                 case ModMetadata::Dependency::Importance::Suggested:
-                    m_problems.push_back({
+                    m_problems.add({
                         LoadProblem::Type::Suggestion,
                         mod,
                         fmt::format("{} {}", dep.id, dep.version.toString())
                     });
-                    log::info("{} suggests {} {}", id, dep.id, dep.version);
+                    log::info("{} suggests {} {}", mod->getID(), dep.id, dep.version);
                     break;
                 case ModMetadata::Dependency::Importance::Recommended:
-                    m_problems.push_back({
+                    m_problems.add({
                         LoadProblem::Type::Recommendation,
                         mod,
                         fmt::format("{} {}", dep.id, dep.version.toString())
                     });
-                    log::warn("{} recommends {} {}", id, dep.id, dep.version);
+                    log::warn("{} recommends {} {}", mod->getID(), dep.id, dep.version);
                     break;
                 case ModMetadata::Dependency::Importance::Required:
-                    m_problems.push_back({
+                    m_problems.add({
                         LoadProblem::Type::MissingDependency,
                         mod,
                         fmt::format("{} {}", dep.id, dep.version.toString())
                     });
-                    log::error("{} requires {} {}", id, dep.id, dep.version);
+                    log::error("{} requires {} {}", mod->getID(), dep.id, dep.version);
                     break;
             }
         }
@@ -473,40 +697,34 @@ void Loader::Impl::findProblems() {
                 continue;
             switch(dep.importance) {
                 case ModMetadata::Incompatibility::Importance::Conflicting:
-                    m_problems.push_back({
+                    m_problems.add({
                         LoadProblem::Type::Conflict,
                         mod,
                         fmt::format("{} {}", dep.id, dep.version.toString())
                     });
-                    log::warn("{} conflicts with {} {}", id, dep.id, dep.version);
+                    log::warn("{} conflicts with {} {}", mod->getID(), dep.id, dep.version);
                     break;
                 case ModMetadata::Incompatibility::Importance::Breaking:
-                    m_problems.push_back({
+                    m_problems.add({
                         LoadProblem::Type::PresentIncompatibility,
                         mod,
                         fmt::format("{} {}", dep.id, dep.version.toString())
                     });
-                    log::error("{} breaks {} {}", id, dep.id, dep.version);
+                    log::error("{} breaks {} {}", mod->getID(), dep.id, dep.version);
                     break;
             }
         }
 
-        Mod* myEpicMod = mod; // clang fix
         // if the mod is not loaded but there are no problems related to it
         if (!mod->isLoaded() &&
             Mod::get()->getSavedValue<bool>("should-load-" + mod->getID(), true) &&
-            !std::any_of(m_problems.begin(), m_problems.end(), [myEpicMod](auto& item) {
-                return std::holds_alternative<ModMetadata>(item.cause) &&
-                    std::get<ModMetadata>(item.cause).getID() == myEpicMod->getID() ||
-                    std::holds_alternative<Mod*>(item.cause) &&
-                    std::get<Mod*>(item.cause) == myEpicMod;
-            })) {
-            m_problems.push_back({
+            !m_problems.has(mod->getID())) {
+            m_problems.add({
                 LoadProblem::Type::Unknown,
                 mod,
                 ""
             });
-            log::error("{} failed to load for an unknown reason", id);
+            log::error("{} failed to load for an unknown reason", mod->getID());
         }
 
         log::popNest();
@@ -526,33 +744,47 @@ void Loader::Impl::refreshModGraph() {
     }
 
     m_problems.clear();
+    {
+        std::lock_guard lock(m_loadingTimesMutex);
+        m_loadingTimes.clear();
+        m_loadingTimesModCount = 0;
+    }
 
     m_loadingState = LoadingState::Queue;
     log::debug("Queueing mods");
     log::pushNest();
+    auto stepBegin = std::chrono::high_resolution_clock::now();
     std::vector<ModMetadata> modQueue;
     this->queueMods(modQueue);
+    this->addLoadingTime(LoadingState::Queue, stepBegin);
     log::popNest();
 
     m_loadingState = LoadingState::List;
     log::debug("Populating mod list");
     log::pushNest();
+    stepBegin = std::chrono::high_resolution_clock::now();
     this->populateModList(modQueue);
     modQueue.clear();
+    this->applyLogLevels();
+    this->addLoadingTime(LoadingState::List, stepBegin);
     log::popNest();
 
     m_loadingState = LoadingState::Graph;
     log::debug("Building mod graph");
     log::pushNest();
+    stepBegin = std::chrono::high_resolution_clock::now();
     this->buildModGraph();
+    this->addLoadingTime(LoadingState::Graph, stepBegin);
     log::popNest();
 
     m_loadingState = LoadingState::EarlyMods;
     log::debug("Loading early mods");
     log::pushNest();
-    for (auto const& dep : ModImpl::get()->m_dependants) {
-        this->loadModGraph(dep, true);
+    stepBegin = std::chrono::high_resolution_clock::now();
+    for (auto const& mod : m_loadOrder) {
+        this->loadModGraph(mod, true);
     }
+    this->addLoadingTime(LoadingState::EarlyMods, stepBegin);
     log::popNest();
 
     auto end = std::chrono::high_resolution_clock::now();
@@ -568,7 +800,7 @@ void Loader::Impl::refreshModGraph() {
 
     queueInMainThread([]() {
         Loader::get()->m_impl->continueRefreshModGraph();
-    });
+    }, Mod::get());
 }
 
 void Loader::Impl::continueRefreshModGraph() {
@@ -576,17 +808,29 @@ void Loader::Impl::continueRefreshModGraph() {
     log::pushNest();
 
     auto begin = std::chrono::high_resolution_clock::now();
+    auto state = m_loadingState;
 
     switch (m_loadingState) {
-        case LoadingState::Mods:
+        case LoadingState::Mods: {
             log::debug("Loading mods");
             log::pushNest();
-            this->loadModGraph(m_modsToLoad.front(), false);
+            // load as many mods as fit in the frame budget before yielding,
+            // so the loading screen keeps updating
+            auto budget = std::chrono::milliseconds(
+                Mod::get()->getSettingValue<int64_t>("mod-load-frame-budget")
+            );
+            do {
+                this->loadModGraph(m_modsToLoad.front(), false);
+                m_modsToLoad.pop();
+            } while (
+                !m_modsToLoad.empty() &&
+                std::chrono::high_resolution_clock::now() - begin < budget
+            );
             log::popNest();
-            m_modsToLoad.pop();
             if (m_modsToLoad.empty())
                 m_loadingState = LoadingState::Problems;
             break;
+        }
         case LoadingState::Problems:
             log::debug("Finding problems");
             log::pushNest();
@@ -604,18 +848,58 @@ void Loader::Impl::continueRefreshModGraph() {
     auto end = std::chrono::high_resolution_clock::now();
     auto time = std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count();
     log::info("Took {}s", static_cast<float>(time) / 1000.f);
+    this->addLoadingTime(state, begin);
 
-    if (m_loadingState != LoadingState::Done) {
+    if (m_loadingState == LoadingState::Done) {
+        log::info("Loading times: {}", this->getLoadingTimes().dump());
+        for (auto& func : std::exchange(m_loadingDoneCallbacks, {})) {
+            func();
+        }
+    }
+    else {
         queueInMainThread([]() {
             Loader::get()->m_impl->continueRefreshModGraph();
-        });
+        }, Mod::get());
     }
 
     log::popNest();
 }
 
+void Loader::Impl::addLoadingTime(LoadingState state, std::chrono::high_resolution_clock::time_point begin) {
+    auto time = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::high_resolution_clock::now() - begin
+    );
+    std::lock_guard lock(m_loadingTimesMutex);
+    m_loadingTimes[state] += time;
+    m_loadingTimesModCount = m_mods.size();
+}
+
+json::Value Loader::Impl::getLoadingTimes() const {
+    static constexpr std::array<std::pair<LoadingState, char const*>, 6> STEPS {{
+        { LoadingState::Queue, "queue" },
+        { LoadingState::List, "list" },
+        { LoadingState::Graph, "graph" },
+        { LoadingState::EarlyMods, "early-mods" },
+        { LoadingState::Mods, "mods" },
+        { LoadingState::Problems, "problems" },
+    }};
+    std::lock_guard lock(m_loadingTimesMutex);
+    json::Value res = json::Object();
+    std::chrono::microseconds total {};
+    for (auto& [state, name] : STEPS) {
+        auto it = m_loadingTimes.find(state);
+        auto time = it != m_loadingTimes.end() ? it->second : std::chrono::microseconds {};
+        res[name] = static_cast<double>(time.count()) / 1000.0;
+        total += time;
+    }
+    res["total"] = static_cast<double>(total.count()) / 1000.0;
+    res["mod-count"] = static_cast<int>(m_loadingTimesModCount);
+    return res;
+}
+
 std::vector<LoadProblem> Loader::Impl::getProblems() const {
-    return m_problems;
+    auto problems = m_problems.all();
+    return std::vector<LoadProblem>(problems.begin(), problems.end());
 }
 
 void Loader::Impl::waitForModsToBeLoaded() {
@@ -630,10 +914,13 @@ bool Loader::Impl::didLastLaunchCrash() const {
 
 void Loader::Impl::forceReset() {
     this->closePlatformConsole();
-    for (auto& [_, mod] : m_mods) {
+    // unregister the mods before deleting them so the IPC thread can't 
+    // find them anymore
+    auto mods = this->getAllMods();
+    m_mods.clear();
+    for (auto mod : mods) {
         delete mod;
     }
-    m_mods.clear();
     log::Logger::clear();
     ghc::filesystem::remove_all(dirs::getModRuntimeDir());
     ghc::filesystem::remove_all(dirs::getTempDir());
@@ -662,29 +949,80 @@ bool Loader::Impl::loadHooks() {
     return !thereWereErrors;
 }
 
-void Loader::Impl::queueInMainThread(ScheduledFunction func) {
-    std::lock_guard<std::mutex> lock(m_gdThreadMutex);
-    m_gdThreadQueue.push_back(func);
+void Loader::Impl::queueInMainThread(ScheduledFunction func, Mod* mod) {
+    m_mainThreadQueue.push(std::move(func), mod);
+}
+
+std::optional<Severity> Loader::Impl::parseSeverity(std::string const& name) {
+    auto lower = utils::string::toLower(utils::string::trim(name));
+    for (int i = Severity::Debug; i <= Severity::Emergency; i++) {
+        auto severity = Severity::cast(i);
+        if (lower == utils::string::toLower(Severity::toString(severity))) {
+            return Severity(severity);
+        }
+    }
+    return std::nullopt;
+}
+
+void Loader::Impl::applyLogLevels() {
+    auto global = parseSeverity(Mod::get()->getSettingValue<std::string>("log-level"));
+    log::Logger::setMinimumSeverity(global.value_or(Severity::Debug));
+
+    // formatted as comma-separated mod.id=severity pairs
+    std::unordered_map<std::string, Severity> levels;
+    auto setting = Mod::get()->getSettingValue<std::string>("mod-log-levels");
+    for (auto const& entry : utils::string::split(setting, ",")) {
+        auto pair = utils::string::trim(entry);
+        if (pair.empty()) {
+            continue;
+        }
+        auto eq = pair.find('=');
+        auto severity = eq != std::string::npos ?
+            parseSeverity(pair.substr(eq + 1)) : std::nullopt;
+        if (!severity) {
+            log::warn("Invalid mod log level \"{}\", expected mod.id=severity", pair);
+            continue;
+        }
+        levels.insert({ utils::string::trim(pair.substr(0, eq)), *severity });
+    }
+
+    auto apply = [&](Mod* mod) {
+        auto it = levels.find(mod->getID());
+        log::Logger::setMinimumSeverity(
+            mod, it != levels.end() ? std::optional(it->second) : std::nullopt
+        );
+    };
+    apply(Mod::get());
+    for (auto mod : this->getAllMods()) {
+        apply(mod);
+    }
+}
+
+TimerHandle Loader::Impl::schedule(
+    std::chrono::milliseconds delay, std::chrono::milliseconds interval,
+    ScheduledFunction func, Mod* mod
+) {
+    return m_timers.schedule(delay, interval, std::move(func), mod);
 }
 
 void Loader::Impl::executeGDThreadQueue() {
-    // copy queue to avoid locking mutex if someone is
-    // running addToGDThread inside their function
-    m_gdThreadMutex.lock();
-    auto queue = m_gdThreadQueue;
-    m_gdThreadQueue.clear();
-    m_gdThreadMutex.unlock();
-
-    // call queue
-    for (auto const& func : queue) {
+    m_timers.update();
+    m_mainThreadQueue.execute();
+}
+
+void Loader::Impl::onLoadingDone(ScheduledFunction func) {
+    if (m_loadingState == LoadingState::Done) {
         func();
     }
+    else {
+        m_loadingDoneCallbacks.push_back(std::move(func));
+    }
 }
 
 void Loader::Impl::logConsoleMessage(std::string const& msg) {
     if (m_platformConsoleOpen) {
-        // TODO: make flushing optional
-        std::cout << msg << '\n' << std::flush;
+        // flushed by the log writer once per batch
+        std::cout << msg << '\n';
     }
 }
 
@@ -1008,7 +1346,7 @@ ResourceDownloadEvent::ResourceDownloadEvent(
 ) : status(status) {}
 
 ListenerResult ResourceDownloadFilter::handle(
-    utils::MiniFunction<Callback> fn,
+    utils::MiniFunction<Callback> const& fn,
     ResourceDownloadEvent* event
 ) {
     fn(event);
@@ -1022,7 +1360,7 @@ LoaderUpdateEvent::LoaderUpdateEvent(
 ) : status(status) {}
 
 ListenerResult LoaderUpdateFilter::handle(
-    utils::MiniFunction<Callback> fn,
+    utils::MiniFunction<Callback> const& fn,
     LoaderUpdateEvent* event
 ) {
     fn(event);
@@ -9,11 +9,18 @@
 #include <Geode/loader/Log.hpp>
 #include <Geode/loader/Mod.hpp>
 #include <Geode/utils/Result.hpp>
+#include <Geode/utils/file.hpp>
 #include <Geode/utils/map.hpp>
 #include <Geode/utils/ranges.hpp>
 #include <Geode/utils/MiniFunction.hpp>
+#include "LoadProblemStore.hpp"
+#include "MainThreadQueue.hpp"
+#include "TimerWheel.hpp"
 #include "ModImpl.hpp"
+#include "ModMetadataCache.hpp"
+#include "ModRegistry.hpp"
 #include <about.hpp>
+#include <chrono>
 #include <crashlog.hpp>
 #include <mutex>
 #include <optional>
@@ -35,7 +42,7 @@ namespace geode {
     public:
         using Callback = void(ResourceDownloadEvent*);
 
-        ListenerResult handle(utils::MiniFunction<Callback> fn, ResourceDownloadEvent* event);
+        ListenerResult handle(utils::MiniFunction<Callback> const& fn, ResourceDownloadEvent* event);
         ResourceDownloadFilter();
     };
 
@@ -48,7 +55,7 @@ namespace geode {
     public:
         using Callback = void(LoaderUpdateEvent*);
 
-        ListenerResult handle(utils::MiniFunction<Callback> fn, LoaderUpdateEvent* event);
+        ListenerResult handle(utils::MiniFunction<Callback> const& fn, LoaderUpdateEvent* event);
         LoaderUpdateFilter();
     };
 
@@ -57,10 +64,15 @@ namespace geode {
         mutable std::mutex m_mutex;
 
         std::vector<ghc::filesystem::path> m_modSearchDirectories;
-        std::vector<LoadProblem> m_problems;
-        std::unordered_map<std::string, Mod*> m_mods;
+        LoadProblemStore m_problems;
+        ModRegistry m_mods;
         std::queue<Mod*> m_modsToLoad;
+        // mods in an order where every mod comes after its dependencies
+        std::vector<Mod*> m_loadOrder;
         std::vector<ghc::filesystem::path> m_texturePaths;
+        ModMetadataCache m_metadataCache;
+        // packages opened while queueing that still need to be extracted
+        std::unordered_map<std::string, utils::file::Unzip> m_packageHandles;
         bool m_isSetup = false;
 
         // cache for the json of the latest github release to avoid hitting 
@@ -69,9 +81,16 @@ namespace geode {
         bool m_isNewUpdateDownloaded = false;
 
         LoadingState m_loadingState;
-
-        std::vector<utils::MiniFunction<void(void)>> m_gdThreadQueue;
-        mutable std::mutex m_gdThreadMutex;
+        // time spent in each loading step, not counting the frames between 
+        // steps. read by the IPC thread, so guarded by the mutex
+        std::unordered_map<LoadingState, std::chrono::microseconds> m_loadingTimes;
+        size_t m_loadingTimesModCount = 0;
+        mutable std::mutex m_loadingTimesMutex;
+
+        MainThreadQueue m_mainThreadQueue;
+        // must come after the main thread queue, which it fires timers into
+        TimerWheel m_timers = TimerWheel(m_mainThreadQueue);
+        std::vector<ScheduledFunction> m_loadingDoneCallbacks;
         bool m_platformConsoleOpen = false;
         std::vector<std::pair<Hook*, Mod*>> m_internalHooks;
         bool m_readyToHook = false;
@@ -133,11 +152,19 @@ namespace geode {
         [[deprecated]] void refreshModsList();
         void queueMods(std::vector<ModMetadata>& modQueue);
         void populateModList(std::vector<ModMetadata>& modQueue);
+        void cleanModRuntimeDir();
         void buildModGraph();
+        void sortModGraph();
         void loadModGraph(Mod* node, bool early);
         void findProblems();
         void refreshModGraph();
         void continueRefreshModGraph();
+        void addLoadingTime(LoadingState state, std::chrono::high_resolution_clock::time_point begin);
+        /**
+         * Get the time spent in each loading step as json, for measuring 
+         * startup performance. Safe to call from any thread
+         */
+        json::Value getLoadingTimes() const;
 
         bool isModInstalled(std::string const& id) const;
         Mod* getInstalledMod(std::string const& id) const;
@@ -158,8 +185,24 @@ namespace geode {
 
         json::Value processRawIPC(void* rawHandle, std::string const& buffer);
 
-        void queueInMainThread(ScheduledFunction func);
+        static std::optional<Severity> parseSeverity(std::string const& name);
+        /**
+         * Apply the global and per-mod minimum log severities from the loader 
+         * settings. Levels set at runtime last until the settings change
+         */
+        void applyLogLevels();
+
+        void queueInMainThread(ScheduledFunction func, Mod* mod);
+        TimerHandle schedule(
+            std::chrono::milliseconds delay, std::chrono::milliseconds interval,
+            ScheduledFunction func, Mod* mod
+        );
         void executeGDThreadQueue();
+        /**
+         * Run a function on the main thread once every mod has been loaded, 
+         * or right away if they already have
+         */
+        void onLoadingDone(ScheduledFunction func);
 
         void logConsoleMessage(std::string const& msg);
         void logConsoleMessageWithSeverity(std::string const& msg, Severity severity);
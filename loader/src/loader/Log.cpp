@@ -1,4 +1,7 @@
 #include "LoaderImpl.hpp"
+#include "LogRing.hpp"
+#include "LogSink.hpp"
+#include "ModImpl.hpp"
 
 #include <Geode/loader/Dirs.hpp>
 #include <Geode/loader/Log.hpp>
@@ -8,6 +11,7 @@
 #include <fmt/chrono.h>
 #include <fmt/format.h>
 #include <iomanip>
+#include <iterator>
 
 using namespace geode::prelude;
 using namespace geode::log;
@@ -17,7 +21,7 @@ using namespace cocos2d;
 
 std::string log::parse(Mod* mod) {
     if (mod) {
-        return fmt::format("{{ Mod, {} }}", mod->getName());
+        return fmt::format("{{ Mod, {} }}", mod->getNameRef());
     }
     else {
         return "{ Mod, null }";
@@ -108,21 +112,7 @@ std::string Log::toString(bool logTime) const {
 }
 std::string Log::toString(bool logTime, uint32_t nestLevel) const {
     std::string res;
-
-    if (logTime) {
-        res += fmt::format("{:%H:%M:%S}", m_time);
-    }
-
-    res += fmt::format(" [{}]: ", m_sender ? m_sender->getName() : "Geode?");
-
-    for (uint32_t i = 0; i < nestLevel; i++) {
-        res += "  ";
-    }
-
-    for (auto& i : m_components) {
-        res += i->_toString();
-    }
-
+    LogSink::formatLine(res, m_time, m_sender, nestLevel, m_content, logTime);
     return res;
 }
 
@@ -142,6 +132,10 @@ Severity Log::getSeverity() const {
     return m_severity;
 }
 
+std::string const& Log::getContent() const {
+    return m_content;
+}
+
 void Log::addFormat(std::string_view formatStr, std::span<ComponentTrait*> components) {
     auto res = this->addFormatNew(formatStr, components);
     if (res.isErr()) {
@@ -149,89 +143,145 @@ void Log::addFormat(std::string_view formatStr, std::span<ComponentTrait*> compo
     }
 }
 
-Result<> Log::addFormatNew(std::string_view formatStr, std::span<ComponentTrait*> components) {
-    size_t compIndex = 0;
-    std::string current;
-    for (size_t i = 0; i < formatStr.size(); ++i) {
+// Applies a format string with {} placeholders, calling append for each 
+// argument in order
+template <class Append>
+static Result<> applyFormat(
+    fmt::memory_buffer& out, std::string_view formatStr, size_t argCount, Append&& append
+) {
+    size_t argIndex = 0;
+    size_t i = 0;
+    while (i < formatStr.size()) {
+        auto const special = formatStr.find_first_of("{}", i);
+        auto const literal = formatStr.substr(i, special - i);
+        out.append(literal.data(), literal.data() + literal.size());
+        if (special == std::string_view::npos) {
+            break;
+        }
+        i = special;
+
         if (formatStr[i] == '{') {
             if (i == formatStr.size() - 1) {
                 return Err("Unescaped { at the end of format string");
             }
             auto const next = formatStr[i + 1];
             if (next == '{') {
-                current.push_back('{');
-                ++i;
+                out.push_back('{');
+                i += 2;
                 continue;
             }
             if (next == '}') {
-                if (compIndex >= components.size()) {
+                if (argIndex >= argCount) {
                     return Err("Not enough arguments for format string");
                 }
-                
-                m_components.push_back(new ComponentBase(current));
-                m_components.push_back(components[compIndex++]);
-
-                current.clear();
-                ++i;
+                append(argIndex++);
+                i += 2;
                 continue;
             }
             return Err("You put something in between {} silly head");
         }
-        if (formatStr[i] == '}') {
-            if (i == formatStr.size() - 1) {
-                return Err("Unescaped } at the end of format string");
-            }
-            if (formatStr[i + 1] == '}') {
-                current.push_back('}');
-                ++i;
-                continue;
-            }
-            return Err("You have an unescaped }");
+        if (i == formatStr.size() - 1) {
+            return Err("Unescaped } at the end of format string");
         }
-
-        current.push_back(formatStr[i]);
+        if (formatStr[i + 1] == '}') {
+            out.push_back('}');
+            i += 2;
+            continue;
+        }
+        return Err("You have an unescaped }");
     }
 
-    if (!current.empty())
-        m_components.push_back(new ComponentBase(current));
-
-    if (compIndex != components.size()) {
+    if (argIndex != argCount) {
         return Err("You have left over arguments.. silly head");
     }
 
     return Ok();
 }
 
-// Logger
-
-std::vector<Log>& Logger::logs() {
-    static std::vector<Log> logs;
-    return logs;
+Result<> Log::addFormatNew(std::string_view formatStr, std::span<ComponentTrait*> components) {
+    // the log owns the components either way
+    m_components.insert(m_components.end(), components.begin(), components.end());
+
+    fmt::memory_buffer out;
+    GEODE_UNWRAP(applyFormat(out, formatStr, components.size(), [&](size_t index) {
+        auto str = components[index]->_toString();
+        out.append(str.data(), str.data() + str.size());
+    }));
+    m_content.append(out.data(), out.size());
+    return Ok();
 }
-std::ofstream& Logger::logStream() {
-    static std::ofstream logStream;
-    return logStream;
+
+Result<> Log::addFormatArgs(std::string_view formatStr, std::span<LogArg const> args) {
+    fmt::memory_buffer out;
+    GEODE_UNWRAP(applyFormat(out, formatStr, args.size(), [&](size_t index) {
+        args[index].append(out, args[index].value);
+    }));
+    m_content.append(out.data(), out.size());
+    return Ok();
 }
+
+// Logger
+
 uint32_t& Logger::nestLevel() {
-    static std::uint32_t nestLevel = 0;
+    // mods are parsed and extracted on worker threads during startup, which
+    // must not fight over the nesting of the thread that spawned them
+    static thread_local std::uint32_t nestLevel = 0;
     return nestLevel;
 }
 
-void Logger::setup() {
-    logStream() = std::ofstream(dirs::getGeodeLogDir() / log::generateLogName());
+static std::atomic<Severity::type> s_minimumSeverity = Severity::Debug;
+
+bool Logger::isEnabled(Severity severity, Mod* mod) {
+    int minimum = mod ? ModImpl::getImpl(mod)->m_minLogSeverity.load(std::memory_order_relaxed) : -1;
+    if (minimum < 0) {
+        minimum = s_minimumSeverity.load(std::memory_order_relaxed);
+    }
+    return severity.m_value >= minimum;
 }
 
-void Logger::push(Log&& log) {
-    std::string logStr = log.toString(true, nestLevel());
+void Logger::setMinimumSeverity(Severity severity) {
+    s_minimumSeverity = severity.m_value;
+}
 
-    LoaderImpl::get()->logConsoleMessageWithSeverity(logStr, log.getSeverity());
-    logStream() << logStr << std::endl;
+Severity Logger::getMinimumSeverity() {
+    return s_minimumSeverity.load();
+}
 
-    logs().emplace_back(std::forward<Log>(log));
+void Logger::setMinimumSeverity(Mod* mod, std::optional<Severity> severity) {
+    if (mod) {
+        ModImpl::getImpl(mod)->m_minLogSeverity = severity ? severity->m_value : -1;
+    }
+}
+
+std::optional<Severity> Logger::getMinimumSeverity(Mod* mod) {
+    if (!mod) {
+        return std::nullopt;
+    }
+    auto minimum = ModImpl::getImpl(mod)->m_minLogSeverity.load();
+    if (minimum < 0) {
+        return std::nullopt;
+    }
+    return Severity::cast(minimum);
+}
+
+void Logger::setup() {
+    LogSink::get()->start(dirs::getGeodeLogDir());
+}
+
+void Logger::push(Log&& log) {
+    // both the sink and the ring are safe to push to from any thread, so 
+    // logs from different threads aren't serialized here. Two logs made at 
+    // the same time may then end up in a different order in the file than 
+    // in memory, which is fine since they're both stamped with their time
+    LogSink::get()->push(
+        log.getTime(), log.getSender(), nestLevel(), log.getSeverity(), log.getContent()
+    );
+
+    LogRing::get()->push(std::forward<Log>(log));
 }
 
 void Logger::pop(Log* log) {
-    geode::utils::ranges::remove(Logger::logs(), *log);
+    LogRing::get()->remove(log);
 }
 
 void Logger::pushNest() {
@@ -246,16 +296,15 @@ void Logger::popNest() {
 }
 
 std::vector<Log*> Logger::list() {
-    std::vector<Log*> logs_;
-    logs_.reserve(logs().size());
-    for (auto& log : logs()) {
-        logs_.push_back(&log);
-    }
-    return logs_;
+    return LogRing::get()->list();
+}
+
+LogPage Logger::query(LogQuery const& query) {
+    return LogRing::get()->query(query);
 }
 
 void Logger::clear() {
-    logs().clear();
+    LogRing::get()->clear();
 }
 
 // Misc
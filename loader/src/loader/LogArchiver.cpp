@@ -0,0 +1,141 @@
+#include "LogArchiver.hpp"
+#include "LogSink.hpp"
+
+#include <Geode/loader/Log.hpp>
+#include <../platform/IncludeZlib.h>
+#include <algorithm>
+#include <fstream>
+#include <ghc/filesystem.hpp>
+#include <thread>
+#include <vector>
+
+using namespace geode::prelude;
+
+LogArchiver* LogArchiver::get() {
+    static auto inst = new LogArchiver();
+    return inst;
+}
+
+void LogArchiver::setRetention(size_t maxFiles, std::chrono::hours maxAge) {
+    m_maxFiles = std::max<size_t>(maxFiles, 1);
+    m_maxAge = maxAge.count();
+}
+
+void LogArchiver::schedule(ghc::filesystem::path const& dir) {
+    if (m_running.exchange(true)) {
+        m_again = true;
+        return;
+    }
+    std::thread([this, dir]() {
+        while (true) {
+            this->archive(dir);
+            m_running = false;
+            // somebody asked for another pass while this one was going
+            if (!m_again.exchange(false) || m_running.exchange(true)) {
+                break;
+            }
+        }
+    }).detach();
+}
+
+void LogArchiver::archive(ghc::filesystem::path const& dir) {
+    std::error_code ec;
+    std::vector<ghc::filesystem::path> files;
+    for (auto const& entry : ghc::filesystem::directory_iterator(dir, ec)) {
+        if (entry.is_regular_file(ec)) {
+            files.push_back(entry.path());
+        }
+    }
+    // taken after listing the directory, so any other file listed has 
+    // already been rotated out and closed
+    auto current = LogSink::get()->getPath();
+
+    std::vector<std::pair<ghc::filesystem::path, ghc::filesystem::file_time_type>> archives;
+    for (auto& file : files) {
+        if (file == current) {
+            continue;
+        }
+        if (file.extension() == ".log") {
+            auto res = compress(file);
+            if (!res) {
+                log::warn("Unable to compress log {}: {}", file.filename().string(), res.unwrapErr());
+                continue;
+            }
+            file += ".gz";
+        }
+        else if (file.extension() != ".gz" || file.stem().extension() != ".log") {
+            continue;
+        }
+        archives.push_back({ file, ghc::filesystem::last_write_time(file, ec) });
+    }
+
+    // newest first
+    std::sort(archives.begin(), archives.end(), [](auto const& a, auto const& b) {
+        return a.second > b.second;
+    });
+    auto cutoff = ghc::filesystem::file_time_type::clock::now() - std::chrono::hours(m_maxAge);
+    for (size_t i = 0; i < archives.size(); i++) {
+        if (i >= m_maxFiles || archives[i].second < cutoff) {
+            ghc::filesystem::remove(archives[i].first, ec);
+        }
+    }
+}
+
+Result<> LogArchiver::compress(ghc::filesystem::path const& path) {
+    static constexpr size_t CHUNK_SIZE = 64 * 1024;
+
+    auto target = path;
+    target += ".gz";
+
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        return Err("Unable to open file");
+    }
+    std::ofstream out(target, std::ios::binary);
+    if (!out) {
+        return Err("Unable to create archive");
+    }
+
+    z_stream stream {};
+    // 16 added to the window bits makes zlib write a gzip header
+    if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return Err("Unable to initialize zlib");
+    }
+
+    std::vector<char> input(CHUNK_SIZE);
+    std::vector<char> output(CHUNK_SIZE);
+    int flush = Z_NO_FLUSH;
+    do {
+        in.read(input.data(), input.size());
+        if (in.bad()) {
+            break;
+        }
+        stream.next_in = reinterpret_cast<Bytef*>(input.data());
+        stream.avail_in = static_cast<uInt>(in.gcount());
+        flush = in.eof() ? Z_FINISH : Z_NO_FLUSH;
+        do {
+            stream.next_out = reinterpret_cast<Bytef*>(output.data());
+            stream.avail_out = static_cast<uInt>(output.size());
+            deflate(&stream, flush);
+            out.write(output.data(), output.size() - stream.avail_out);
+        } while (stream.avail_out == 0);
+    } while (flush != Z_FINISH);
+    deflateEnd(&stream);
+
+    std::error_code ec;
+    if (in.bad() || !out) {
+        out.close();
+        ghc::filesystem::remove(target, ec);
+        return Err("Unable to write archive");
+    }
+    in.close();
+    out.close();
+
+    // keep the original time so archives are cleaned up in the right order
+    auto time = ghc::filesystem::last_write_time(path, ec);
+    if (!ec) {
+        ghc::filesystem::last_write_time(target, time, ec);
+    }
+    ghc::filesystem::remove(path, ec);
+    return Ok();
+}
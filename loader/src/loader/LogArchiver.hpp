@@ -0,0 +1,39 @@
+#pragma once
+
+#include <Geode/utils/Result.hpp>
+#include <ghc/fs_fwd.hpp>
+#include <atomic>
+#include <chrono>
+
+namespace geode {
+    /**
+     * Keeps the log directory from growing forever. Log files that are no 
+     * longer being written to (from previous sessions, or rotated out during 
+     * this one) are gzipped, and the oldest archives past the retention 
+     * limits are deleted. All of it happens on a background thread
+     */
+    class LogArchiver final {
+    private:
+        std::atomic_bool m_running = false;
+        std::atomic_bool m_again = false;
+        std::atomic_size_t m_maxFiles = 30;
+        std::atomic<std::chrono::hours::rep> m_maxAge = 14 * 24;
+
+        void archive(ghc::filesystem::path const& dir);
+
+    public:
+        static LogArchiver* get();
+
+        void setRetention(size_t maxFiles, std::chrono::hours maxAge);
+        /**
+         * Archive and clean up the log directory in the background. If it's 
+         * already being done, it's done again once that finishes
+         */
+        void schedule(ghc::filesystem::path const& dir);
+
+        /**
+         * Compress a file into a .gz next to it and delete the original
+         */
+        static Result<> compress(ghc::filesystem::path const& path);
+    };
+}
@@ -0,0 +1,219 @@
+#include "LogRing.hpp"
+
+#include <algorithm>
+
+using namespace geode::prelude;
+
+static size_t severityIndex(Severity severity) {
+    return std::min<size_t>(severity.m_value, Severity::Emergency);
+}
+
+LogRing::LogRing() {
+    // the storage is never reallocated while the ring fills up, so a push 
+    // only ever touches the slot it writes to
+    m_logs.reserve(m_capacity);
+    m_removed.reserve(m_capacity);
+}
+
+LogRing* LogRing::get() {
+    static auto inst = new LogRing();
+    return inst;
+}
+
+size_t LogRing::slot(uint64_t position) const {
+    return (position - m_base) % m_capacity;
+}
+
+bool LogRing::matches(uint64_t position, log::LogQuery const& query) const {
+    auto index = this->slot(position);
+    if (m_removed[index]) {
+        return false;
+    }
+    auto& log = m_logs[index];
+    if (query.mod && log.getSender() != query.mod) {
+        return false;
+    }
+    if (log.getSeverity().m_value < query.minSeverity.m_value) {
+        return false;
+    }
+    if (query.from && log.getTime() < *query.from) {
+        return false;
+    }
+    if (query.until && log.getTime() > *query.until) {
+        return false;
+    }
+    return true;
+}
+
+void LogRing::index(uint64_t position, log::Log const& log) {
+    m_byMod[log.getSender()].push_back(position);
+    m_bySeverity[severityIndex(log.getSeverity())].push_back(position);
+}
+
+void LogRing::unindex(log::Log const& log) {
+    // logs are always dropped oldest first, so they're at the front
+    auto mod = m_byMod.find(log.getSender());
+    if (mod != m_byMod.end()) {
+        mod->second.pop_front();
+        if (mod->second.empty()) {
+            m_byMod.erase(mod);
+        }
+    }
+    auto& severity = m_bySeverity[severityIndex(log.getSeverity())];
+    if (!severity.empty()) {
+        severity.pop_front();
+    }
+}
+
+void LogRing::push(log::Log&& log) {
+    std::lock_guard lock(m_mutex);
+    auto position = m_next++;
+    if (m_logs.size() < m_capacity) {
+        this->index(position, log);
+        m_logs.push_back(std::move(log));
+        m_removed.push_back(false);
+        return;
+    }
+    auto index = this->slot(position);
+    this->unindex(m_logs[index]);
+    // destroy the dropped log here rather than leaving it to the caller
+    auto dropped = std::move(m_logs[index]);
+    m_logs[index] = std::move(log);
+    m_removed[index] = false;
+    this->index(position, m_logs[index]);
+}
+
+void LogRing::remove(log::Log* log) {
+    std::lock_guard lock(m_mutex);
+    if (m_logs.empty() || log < m_logs.data() || log >= m_logs.data() + m_logs.size()) {
+        return;
+    }
+    // removed logs stay in the indexes until they're dropped, and are just 
+    // skipped over by queries
+    m_removed[log - m_logs.data()] = true;
+}
+
+void LogRing::clear() {
+    std::lock_guard lock(m_mutex);
+    m_logs.clear();
+    m_removed.clear();
+    m_byMod.clear();
+    for (auto& severity : m_bySeverity) {
+        severity.clear();
+    }
+    m_base = m_next;
+}
+
+void LogRing::setCapacity(size_t capacity) {
+    std::lock_guard lock(m_mutex);
+    capacity = std::max<size_t>(capacity, 1);
+    if (capacity == m_capacity) {
+        return;
+    }
+
+    auto count = std::min(m_logs.size(), capacity);
+    auto first = m_next - count;
+    std::vector<log::Log> logs;
+    std::vector<bool> removed;
+    logs.reserve(capacity);
+    removed.reserve(capacity);
+    for (auto position = first; position < m_next; position++) {
+        auto index = this->slot(position);
+        logs.push_back(std::move(m_logs[index]));
+        removed.push_back(m_removed[index]);
+    }
+
+    m_logs = std::move(logs);
+    m_removed = std::move(removed);
+    m_capacity = capacity;
+    m_base = first;
+
+    m_byMod.clear();
+    for (auto& severity : m_bySeverity) {
+        severity.clear();
+    }
+    for (auto position = first; position < m_next; position++) {
+        this->index(position, m_logs[this->slot(position)]);
+    }
+}
+
+size_t LogRing::getCapacity() const {
+    std::lock_guard lock(m_mutex);
+    return m_capacity;
+}
+
+std::vector<log::Log*> LogRing::list() {
+    std::lock_guard lock(m_mutex);
+    std::vector<log::Log*> res;
+    res.reserve(m_logs.size());
+    for (auto position = m_next - m_logs.size(); position < m_next; position++) {
+        auto index = this->slot(position);
+        if (!m_removed[index]) {
+            res.push_back(&m_logs[index]);
+        }
+    }
+    return res;
+}
+
+log::LogPage LogRing::query(log::LogQuery const& query) {
+    std::lock_guard lock(m_mutex);
+    log::LogPage page;
+    if (query.limit == 0) {
+        return page;
+    }
+
+    auto end = query.before ? std::min(*query.before, m_next) : m_next;
+    // returns false once the page is full
+    auto visit = [&](uint64_t position) {
+        if (!this->matches(position, query)) {
+            return true;
+        }
+        if (page.logs.size() == query.limit) {
+            page.next = position + 1;
+            return false;
+        }
+        // copied so the page stays valid once the lock is released and the 
+        // logs get dropped
+        auto& log = m_logs[this->slot(position)];
+        page.logs.push_back({ log.getSender(), log.getTime(), log.getSeverity(), log.getContent() });
+        return true;
+    };
+
+    // walk whichever index narrows things down, newest first
+    if (query.mod) {
+        auto it = m_byMod.find(query.mod);
+        if (it == m_byMod.end()) {
+            return page;
+        }
+        auto& positions = it->second;
+        auto from = std::lower_bound(positions.begin(), positions.end(), end);
+        while (from != positions.begin() && visit(*--from));
+    }
+    else if (severityIndex(query.minSeverity) > Severity::Debug) {
+        using Iter = std::deque<uint64_t>::const_iterator;
+        std::vector<std::pair<Iter, Iter>> lanes;
+        for (size_t i = severityIndex(query.minSeverity); i < SEVERITY_COUNT; i++) {
+            auto& positions = m_bySeverity[i];
+            auto from = std::lower_bound(positions.begin(), positions.end(), end);
+            if (from != positions.begin()) {
+                lanes.push_back({ positions.begin(), from });
+            }
+        }
+        while (!lanes.empty()) {
+            auto newest = std::max_element(lanes.begin(), lanes.end(), [](auto const& a, auto const& b) {
+                return *std::prev(a.second) < *std::prev(b.second);
+            });
+            if (!visit(*--newest->second)) {
+                break;
+            }
+            if (newest->second == newest->first) {
+                lanes.erase(newest);
+            }
+        }
+    }
+    else {
+        auto oldest = m_next - m_logs.size();
+        for (auto position = end; position > oldest && visit(position - 1); position--);
+    }
+    return page;
+}
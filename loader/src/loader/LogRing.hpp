@@ -0,0 +1,70 @@
+#pragma once
+
+#include <Geode/loader/Log.hpp>
+#include <array>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace geode {
+    /**
+     * The logs kept in memory for the session. Holds up to a set amount of 
+     * logs, after which the oldest ones are dropped to make room. Every log 
+     * gets a position that keeps increasing for the whole session, and the 
+     * positions of the logs currently held are also indexed by sender and by 
+     * severity so that querying the logs of one mod or only warnings and 
+     * errors doesn't have to go through everything else. Safe to use from 
+     * any thread, but pointers to logs are only valid until the next push, 
+     * since a push may overwrite the slot they point to
+     */
+    class LogRing final {
+    public:
+        static constexpr size_t DEFAULT_CAPACITY = 5000;
+
+    private:
+        static constexpr size_t SEVERITY_COUNT = static_cast<size_t>(Severity::Emergency) + 1;
+
+        mutable std::mutex m_mutex;
+        // the log at a position is at (position - m_base) % m_capacity
+        std::vector<log::Log> m_logs;
+        std::vector<bool> m_removed;
+        size_t m_capacity = DEFAULT_CAPACITY;
+        uint64_t m_base = 0;
+        // position of the next log pushed; the oldest log held is at 
+        // m_next - m_logs.size()
+        uint64_t m_next = 0;
+
+        // positions, oldest first
+        std::unordered_map<Mod*, std::deque<uint64_t>> m_byMod;
+        std::array<std::deque<uint64_t>, SEVERITY_COUNT> m_bySeverity;
+
+        size_t slot(uint64_t position) const;
+        bool matches(uint64_t position, log::LogQuery const& query) const;
+        void index(uint64_t position, log::Log const& log);
+        void unindex(log::Log const& log);
+
+        LogRing();
+
+    public:
+        static LogRing* get();
+
+        void push(log::Log&& log);
+        void remove(log::Log* log);
+        void clear();
+
+        /**
+         * Change how many logs are held, keeping the newest ones if there 
+         * are now too many
+         */
+        void setCapacity(size_t capacity);
+        size_t getCapacity() const;
+
+        /**
+         * Every log held, oldest first. The pointers are only valid until 
+         * the next push
+         */
+        std::vector<log::Log*> list();
+        log::LogPage query(log::LogQuery const& query);
+    };
+}
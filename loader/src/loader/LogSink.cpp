@@ -0,0 +1,289 @@
+#include "LogSink.hpp"
+#include "LoaderImpl.hpp"
+#include "LogArchiver.hpp"
+
+#include <Geode/loader/Mod.hpp>
+#include <fmt/chrono.h>
+#include <fmt/format.h>
+#include <ghc/filesystem.hpp>
+#include <iostream>
+#include <thread>
+
+using namespace geode::prelude;
+
+static_assert((LogSink::CAPACITY & (LogSink::CAPACITY - 1)) == 0, "Capacity must be a power of two");
+
+LogSink::LogSink() : m_cells(new Cell[CAPACITY]), m_lastFlush(std::chrono::steady_clock::now()) {
+    for (size_t i = 0; i < CAPACITY; i++) {
+        m_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+LogSink* LogSink::get() {
+    static auto inst = new LogSink();
+    return inst;
+}
+
+void LogSink::formatLine(
+    std::string& out, log::log_clock::time_point time, Mod* sender,
+    uint32_t nestLevel, std::string_view content, bool logTime
+) {
+    if (logTime) {
+        fmt::format_to(std::back_inserter(out), "{:%H:%M:%S}", time);
+    }
+    fmt::format_to(
+        std::back_inserter(out), " [{}]: ",
+        sender ? std::string_view(sender->getNameRef()) : "Geode?"
+    );
+    out.append(nestLevel * 2, ' ');
+    out += content;
+}
+
+bool LogSink::tryPush(Record& record) {
+    auto pos = m_enqueuePos.load(std::memory_order_relaxed);
+    while (true) {
+        auto& cell = m_cells[pos & (CAPACITY - 1)];
+        auto seq = cell.sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+        if (diff == 0) {
+            if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                cell.record = std::move(record);
+                cell.sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        }
+        // the writer hasn't gotten to this cell since the last time around
+        else if (diff < 0) {
+            return false;
+        }
+        else {
+            pos = m_enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool LogSink::tryPop(Record& record) {
+    auto pos = m_dequeuePos.load(std::memory_order_relaxed);
+    auto& cell = m_cells[pos & (CAPACITY - 1)];
+    auto seq = cell.sequence.load(std::memory_order_acquire);
+    if (static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1) < 0) {
+        return false;
+    }
+    record = std::move(cell.record);
+    cell.sequence.store(pos + CAPACITY, std::memory_order_release);
+    m_dequeuePos.store(pos + 1, std::memory_order_relaxed);
+    return true;
+}
+
+bool LogSink::hasPending() const {
+    auto pos = m_dequeuePos.load(std::memory_order_relaxed);
+    auto& cell = m_cells[pos & (CAPACITY - 1)];
+    return cell.sequence.load(std::memory_order_acquire) == pos + 1;
+}
+
+size_t LogSink::drain(bool forceFlush) {
+    size_t count = 0;
+    bool error = false;
+    Record record;
+    while (this->tryPop(record)) {
+        m_line.clear();
+        formatLine(m_line, record.time, record.sender, record.nestLevel, record.content);
+        LoaderImpl::get()->logConsoleMessageWithSeverity(m_line, record.severity);
+        m_batch += m_line;
+        m_batch += '\n';
+        error |= record.severity >= Severity::Error;
+        count += 1;
+    }
+    if (count) {
+        if (m_file.is_open()) {
+            m_file.write(m_batch.data(), m_batch.size());
+            m_fileSize += m_batch.size();
+            m_dirty = true;
+        }
+        m_batch.clear();
+        std::cout.flush();
+        m_written += count;
+    }
+    auto now = std::chrono::steady_clock::now();
+    if (m_dirty && (forceFlush || error || now - m_lastFlush >= FLUSH_INTERVAL)) {
+        m_file.flush();
+        m_dirty = false;
+        m_lastFlush = now;
+    }
+    // rotating is left to the writer thread so a forced drain while the 
+    // process is dying doesn't start anything new
+    if (
+        m_running && m_file.is_open() &&
+        (m_fileSize >= m_maxFileSize || now - m_fileOpened >= m_maxFileAge)
+    ) {
+        this->openFile();
+        LogArchiver::get()->schedule(m_dir);
+    }
+    return count;
+}
+
+size_t LogSink::drainStopped(bool forceFlush) {
+    std::lock_guard lock(m_abandoned ? m_abandonedMutex : m_writeMutex);
+    return this->drain(forceFlush);
+}
+
+void LogSink::openFile() {
+    auto path = m_dir / log::generateLogName();
+    // rotating more than once a second would otherwise reuse the name
+    for (size_t i = 2; ghc::filesystem::exists(path); i++) {
+        path = m_dir / fmt::format("{} ({}).log", path.stem().string(), i);
+    }
+    m_file = std::ofstream(path, std::ios::binary);
+    m_fileSize = 0;
+    m_fileOpened = std::chrono::steady_clock::now();
+    m_dirty = false;
+    std::lock_guard lock(m_pathMutex);
+    m_path = path;
+}
+
+void LogSink::run() {
+    while (m_running) {
+        size_t count;
+        auto forceFlush = m_flushTarget > m_flushedPos;
+        {
+            std::lock_guard lock(m_writeMutex);
+            count = this->drain(forceFlush);
+        }
+        if (forceFlush) {
+            {
+                std::lock_guard lock(m_flushMutex);
+                m_flushedPos = m_dequeuePos.load(std::memory_order_relaxed);
+            }
+            m_flushed.notify_all();
+        }
+        if (count) {
+            continue;
+        }
+        std::unique_lock lock(m_wakeMutex);
+        m_sleeping = true;
+        // a line may have been pushed (or a flush requested) after draining 
+        // but before we were marked as sleeping, in which case nobody is 
+        // going to wake us
+        if (!this->hasPending() && m_flushTarget <= m_flushedPos) {
+            // wake up every flush interval regardless so lines don't sit in 
+            // the file buffer indefinitely
+            m_wake.wait_for(lock, FLUSH_INTERVAL, [this] { return !m_sleeping; });
+        }
+        m_sleeping = false;
+    }
+}
+
+void LogSink::start(ghc::filesystem::path const& dir) {
+    {
+        std::lock_guard lock(m_writeMutex);
+        m_dir = dir;
+        this->openFile();
+    }
+    // clean up after previous sessions
+    LogArchiver::get()->schedule(dir);
+    if (!m_running.exchange(true)) {
+        std::thread writer(&LogSink::run, this);
+        m_writerThread = writer.get_id();
+        writer.detach();
+        // the writer thread is gone by the time static destructors run, so 
+        // write out whatever it didn't get to
+        std::atexit([]() {
+            LogSink::get()->shutdown();
+        });
+    }
+}
+
+void LogSink::push(
+    log::log_clock::time_point time, Mod* sender, uint32_t nestLevel,
+    Severity severity, std::string content
+) {
+    Record record { time, sender, nestLevel, severity, std::move(content) };
+    bool stalled = false;
+    while (!this->tryPush(record)) {
+        if (!stalled) {
+            stalled = true;
+            m_stalls += 1;
+        }
+        if (m_running) {
+            if (m_sleeping.exchange(false)) {
+                m_wake.notify_one();
+            }
+            std::this_thread::yield();
+        }
+        else {
+            this->drainStopped(false);
+        }
+    }
+    if (!m_running) {
+        // nobody else is going to write it
+        this->drainStopped(false);
+    }
+    else if (m_sleeping.exchange(false)) {
+        m_wake.notify_one();
+    }
+}
+
+bool LogSink::flush(std::chrono::milliseconds timeout) {
+    if (!m_running) {
+        this->drainStopped(true);
+        return true;
+    }
+    // the writer would be waiting on itself
+    if (std::this_thread::get_id() == m_writerThread) {
+        return false;
+    }
+    auto target = m_enqueuePos.load(std::memory_order_relaxed);
+    auto requested = m_flushTarget.load();
+    while (requested < target && !m_flushTarget.compare_exchange_weak(requested, target));
+    if (m_sleeping.exchange(false)) {
+        m_wake.notify_one();
+    }
+    std::unique_lock lock(m_flushMutex);
+    return m_flushed.wait_for(lock, timeout, [&] {
+        return m_flushedPos >= target;
+    });
+}
+
+void LogSink::shutdown() {
+    m_running = false;
+    if (m_sleeping.exchange(false)) {
+        m_wake.notify_one();
+    }
+    // give the writer a moment to finish what it's writing, unless it's the 
+    // thread calling this (crashing), in which case it may be holding the 
+    // lock itself
+    if (std::this_thread::get_id() != m_writerThread) {
+        std::unique_lock lock(m_writeMutex, std::defer_lock);
+        auto until = std::chrono::steady_clock::now() + std::chrono::milliseconds(200);
+        while (!lock.try_lock() && std::chrono::steady_clock::now() < until) {
+            std::this_thread::yield();
+        }
+        if (lock.owns_lock()) {
+            this->drain(true);
+            return;
+        }
+    }
+    // the writer died while holding the lock, so it's never going to be 
+    // released and nobody else is going to touch the file again
+    m_abandoned = true;
+    this->drainStopped(true);
+}
+
+void LogSink::setRotation(size_t maxFileSize, std::chrono::hours maxFileAge) {
+    std::lock_guard lock(m_writeMutex);
+    m_maxFileSize = maxFileSize;
+    m_maxFileAge = maxFileAge;
+}
+
+ghc::filesystem::path LogSink::getPath() const {
+    std::lock_guard lock(m_pathMutex);
+    return m_path;
+}
+
+size_t LogSink::getWritten() const {
+    return m_written;
+}
+
+size_t LogSink::getStalls() const {
+    return m_stalls;
+}
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <Geode/loader/Log.hpp>
+#include <Geode/loader/Types.hpp>
+#include <ghc/fs_fwd.hpp>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace geode {
+    /**
+     * Writes log lines to the log file and the platform console from a 
+     * background thread. Logging pushes the message onto a bounded lock-free 
+     * ring, and the writer thread takes everything that has piled up, adds 
+     * the time and sender to each line and writes it all in one go, flushing 
+     * the file every so often (or right away for errors) instead of after 
+     * every line. If the ring is full, logging waits for the writer to make 
+     * room rather than dropping lines.
+     * 
+     * The writer also starts a new file once the current one gets too big or 
+     * too old, and hands the old one to the LogArchiver
+     */
+    class LogSink final {
+    public:
+        static constexpr size_t CAPACITY = 4096;
+        static constexpr std::chrono::milliseconds FLUSH_INTERVAL = std::chrono::milliseconds(500);
+
+    private:
+        struct Record {
+            log::log_clock::time_point time;
+            Mod* sender = nullptr;
+            uint32_t nestLevel = 0;
+            Severity severity = Severity::Debug;
+            std::string content;
+        };
+        struct Cell {
+            // equals the position the cell can next be written at when free, 
+            // and that position plus one once written
+            std::atomic_size_t sequence;
+            Record record;
+        };
+
+        std::unique_ptr<Cell[]> m_cells;
+        alignas(64) std::atomic_size_t m_enqueuePos = 0;
+        // only advanced by whoever holds the write mutex, but the writer 
+        // thread peeks at it while going to sleep
+        alignas(64) std::atomic_size_t m_dequeuePos = 0;
+
+        // held by whoever is draining the ring; only the writer thread, 
+        // unless it hasn't been started or something forces a drain
+        std::mutex m_writeMutex;
+        // set by shutdown if the writer thread never let go of the write 
+        // mutex, in which case this one is used in its place
+        std::atomic_bool m_abandoned = false;
+        std::mutex m_abandonedMutex;
+        std::ofstream m_file;
+        ghc::filesystem::path m_dir;
+        size_t m_fileSize = 0;
+        std::chrono::steady_clock::time_point m_fileOpened;
+        size_t m_maxFileSize = 16 * 1024 * 1024;
+        std::chrono::hours m_maxFileAge = std::chrono::hours(24);
+        // changed under the write mutex, but read by the archiver
+        mutable std::mutex m_pathMutex;
+        ghc::filesystem::path m_path;
+        std::string m_batch;
+        std::string m_line;
+        bool m_dirty = false;
+        std::chrono::steady_clock::time_point m_lastFlush;
+
+        std::mutex m_wakeMutex;
+        std::condition_variable m_wake;
+        std::atomic_bool m_sleeping = false;
+        std::atomic_bool m_running = false;
+        std::thread::id m_writerThread;
+
+        // flush asks the writer to flush the file once the ring has been 
+        // drained up to m_flushTarget; m_flushedPos is how far it had been 
+        // drained the last time the writer did, and is only written by it
+        std::atomic_size_t m_flushTarget = 0;
+        std::mutex m_flushMutex;
+        std::condition_variable m_flushed;
+        size_t m_flushedPos = 0;
+
+        std::atomic_size_t m_written = 0;
+        std::atomic_size_t m_stalls = 0;
+
+        LogSink();
+
+        bool tryPush(Record& record);
+        bool tryPop(Record& record);
+        bool hasPending() const;
+        size_t drain(bool forceFlush);
+        size_t drainStopped(bool forceFlush);
+        void run();
+        void openFile();
+
+    public:
+        static LogSink* get();
+
+        /**
+         * Format a log line the way it appears in the log file
+         */
+        static void formatLine(
+            std::string& out, log::log_clock::time_point time, Mod* sender,
+            uint32_t nestLevel, std::string_view content, bool logTime = true
+        );
+
+        /**
+         * Open a new log file in the directory and start the writer thread. 
+         * Lines logged before this are only written to the console
+         */
+        void start(ghc::filesystem::path const& dir);
+        /**
+         * Set when to move on to a new log file
+         */
+        void setRotation(size_t maxFileSize, std::chrono::hours maxFileAge);
+        /**
+         * Path of the log file currently being written to
+         */
+        ghc::filesystem::path getPath() const;
+        void push(
+            log::log_clock::time_point time, Mod* sender, uint32_t nestLevel,
+            Severity severity, std::string content
+        );
+        /**
+         * Wait until everything logged so far has been written to the file 
+         * and flushed. The writer thread keeps running afterwards
+         * @returns False if the writer didn't get to it before the timeout
+         */
+        bool flush(std::chrono::milliseconds timeout = std::chrono::seconds(1));
+        /**
+         * Stop the writer thread and write out everything it didn't get to 
+         * from the calling thread. Lines logged afterwards are written 
+         * straight away by whoever logs them. Used on exit and when crashing, 
+         * where the writer thread may already be dead (on Windows, threads 
+         * are killed before the atexit handlers of a DLL run), so if it 
+         * doesn't let go of the file in time it's written to regardless
+         */
+        void shutdown();
+
+        size_t getWritten() const;
+        /**
+         * Amount of times logging had to wait for the writer to make room
+         */
+        size_t getStalls() const;
+    };
+}
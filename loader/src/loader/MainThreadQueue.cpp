@@ -0,0 +1,155 @@
+#include "MainThreadQueue.hpp"
+
+#include <Geode/loader/Mod.hpp>
+#include <algorithm>
+
+using namespace geode::prelude;
+
+void MainThreadQueue::push(Job job, Mod* mod) {
+    auto node = new Node { std::move(job), mod, m_incoming.load(std::memory_order_relaxed) };
+    m_depth += 1;
+    while (!m_incoming.compare_exchange_weak(
+        node->next, node, std::memory_order_release, std::memory_order_relaxed
+    ));
+}
+
+void MainThreadQueue::takeIncoming() {
+    auto node = m_incoming.exchange(nullptr, std::memory_order_acquire);
+    // the list is newest first, so reverse it before appending
+    Node* oldest = nullptr;
+    while (node) {
+        auto next = node->next;
+        node->next = oldest;
+        oldest = node;
+        node = next;
+    }
+    while (oldest) {
+        auto next = oldest->next;
+        auto& flow = m_flows[oldest->mod];
+        flow.mod = oldest->mod;
+        if (flow.jobs.empty()) {
+            m_active.push_back(&flow);
+        }
+        flow.jobs.push_back(std::move(oldest->job));
+        delete oldest;
+        oldest = next;
+    }
+}
+
+void MainThreadQueue::execute() {
+    // jobs queued by the jobs ran here wait for the next frame
+    this->takeIncoming();
+    m_maxDepth = std::max<size_t>(m_maxDepth, m_depth);
+
+    auto begin = std::chrono::steady_clock::now();
+    auto overBudget = false;
+    size_t ran = 0;
+    while (!m_active.empty() && !overBudget) {
+        auto flow = m_active.front();
+        m_active.pop_front();
+        flow->deficit += QUANTUM;
+
+        while (!flow->jobs.empty() && flow->deficit.count() > 0) {
+            auto job = std::move(flow->jobs.front());
+            flow->jobs.pop_front();
+            m_depth -= 1;
+
+            auto jobBegin = std::chrono::steady_clock::now();
+            job();
+            auto end = std::chrono::steady_clock::now();
+            auto time = std::chrono::duration_cast<std::chrono::microseconds>(end - jobBegin);
+
+            // charge at least a microsecond so jobs too quick for the clock 
+            // still use up the quantum
+            flow->deficit -= std::max(time, std::chrono::microseconds(1));
+            flow->ran += 1;
+            flow->time += time;
+            ran += 1;
+            if (end - begin >= m_budget) {
+                overBudget = true;
+                break;
+            }
+        }
+
+        if (flow->jobs.empty()) {
+            // idle mods don't get to save up time
+            flow->deficit = {};
+        }
+        else {
+            m_active.push_back(flow);
+        }
+    }
+
+    m_lastRan = ran;
+    m_lastTime = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - begin
+    );
+    if (!m_active.empty()) {
+        m_deferredFrames += 1;
+    }
+    this->publishStats();
+}
+
+void MainThreadQueue::publishStats() {
+    std::unique_lock lock(m_statsMutex);
+    m_stats.budget = m_budget;
+    m_stats.lastRan = m_lastRan;
+    m_stats.lastTime = m_lastTime;
+    m_stats.maxDepth = m_maxDepth;
+    m_stats.deferredFrames = m_deferredFrames;
+    for (auto& [mod, flow] : m_flows) {
+        m_stats.mods[mod] = { flow.jobs.size(), flow.ran, flow.time };
+    }
+}
+
+void MainThreadQueue::setBudget(std::chrono::microseconds budget) {
+    m_budget = budget;
+}
+
+std::chrono::microseconds MainThreadQueue::getBudget() const {
+    return m_budget;
+}
+
+size_t MainThreadQueue::getDepth() const {
+    return m_depth;
+}
+
+MainThreadQueue::ModStats MainThreadQueue::getModStats(Mod* mod) const {
+    std::unique_lock lock(m_statsMutex);
+    auto it = m_stats.mods.find(mod);
+    if (it == m_stats.mods.end()) {
+        return {};
+    }
+    return it->second;
+}
+
+json::Value MainThreadQueue::getStats() const {
+    std::unique_lock lock(m_statsMutex);
+    json::Value res = json::Object();
+    res["depth"] = static_cast<double>(this->getDepth());
+    res["max-depth"] = static_cast<double>(m_stats.maxDepth);
+    res["budget-us"] = static_cast<double>(m_stats.budget.count());
+    res["last-frame-ran"] = static_cast<double>(m_stats.lastRan);
+    res["last-frame-us"] = static_cast<double>(m_stats.lastTime.count());
+    res["frames-over-budget"] = static_cast<double>(m_stats.deferredFrames);
+
+    json::Value mods = json::Object();
+    for (auto& [mod, stats] : m_stats.mods) {
+        json::Value obj = json::Object();
+        obj["depth"] = static_cast<double>(stats.depth);
+        obj["ran"] = static_cast<double>(stats.ran);
+        obj["time-us"] = static_cast<double>(stats.time.count());
+        mods[mod ? mod->getID() : "<unknown>"] = obj;
+    }
+    res["mods"] = mods;
+    return res;
+}
+
+MainThreadQueue::~MainThreadQueue() {
+    auto node = m_incoming.exchange(nullptr);
+    while (node) {
+        auto next = node->next;
+        delete node;
+        node = next;
+    }
+}
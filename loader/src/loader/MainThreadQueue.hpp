@@ -0,0 +1,108 @@
+#pragma once
+
+#include <Geode/utils/MiniFunction.hpp>
+#include <json.hpp>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+namespace geode {
+    class Mod;
+
+    /**
+     * Functions queued to run on the main thread. Queueing pushes onto a
+     * lock-free list so any thread can do it without blocking. Every frame
+     * the main thread takes what was queued and runs jobs until the frame
+     * budget is spent; whatever is left over rolls to the next frame.
+     * 
+     * Jobs are queued per mod and the mods take turns through deficit round 
+     * robin: every turn a mod is given a quantum of time, and runs jobs until 
+     * the time they took adds up to more than its quantum. A mod queueing 
+     * thousands of jobs then only delays the others by a quantum per turn
+     */
+    class MainThreadQueue final {
+    public:
+        using Job = utils::MoveMiniFunction<void()>;
+
+        static constexpr std::chrono::microseconds QUANTUM = std::chrono::microseconds(500);
+
+        struct ModStats {
+            size_t depth = 0;
+            size_t ran = 0;
+            std::chrono::microseconds time {};
+        };
+
+    private:
+        struct Node {
+            Job job;
+            Mod* mod;
+            Node* next;
+        };
+
+        struct Flow {
+            Mod* mod;
+            // oldest first
+            std::deque<Job> jobs;
+            // time the mod may still spend this turn; goes negative if a job 
+            // overruns it, which is paid back on its next turn
+            std::chrono::microseconds deficit {};
+            size_t ran = 0;
+            std::chrono::microseconds time {};
+        };
+
+        // newest first
+        std::atomic<Node*> m_incoming = nullptr;
+        std::atomic_size_t m_depth = 0;
+        // everything below is only touched by the main thread
+        std::unordered_map<Mod*, Flow> m_flows;
+        // mods with jobs waiting, in the order they take turns
+        std::deque<Flow*> m_active;
+        std::chrono::microseconds m_budget = std::chrono::milliseconds(4);
+
+        size_t m_lastRan = 0;
+        std::chrono::microseconds m_lastTime {};
+        size_t m_maxDepth = 0;
+        size_t m_deferredFrames = 0;
+
+        // copy of the stats above, updated at the end of every frame so 
+        // they can be read from other threads (like IPC)
+        struct Stats {
+            std::chrono::microseconds budget {};
+            size_t lastRan = 0;
+            std::chrono::microseconds lastTime {};
+            size_t maxDepth = 0;
+            size_t deferredFrames = 0;
+            std::unordered_map<Mod*, ModStats> mods;
+        };
+        mutable std::mutex m_statsMutex;
+        Stats m_stats;
+
+        void takeIncoming();
+        void publishStats();
+
+    public:
+        void push(Job job, Mod* mod);
+        /**
+         * Run queued jobs until the budget is spent. At least one job is ran 
+         * every frame so a job longer than the budget can't block the queue
+         */
+        void execute();
+
+        void setBudget(std::chrono::microseconds budget);
+        std::chrono::microseconds getBudget() const;
+
+        /**
+         * Amount of jobs queued but not yet ran
+         */
+        size_t getDepth() const;
+        /**
+         * Stats as of the end of the last frame. Safe to call from any thread
+         */
+        ModStats getModStats(Mod* mod) const;
+        json::Value getStats() const;
+
+        ~MainThreadQueue();
+    };
+}
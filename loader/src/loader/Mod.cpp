@@ -85,6 +85,22 @@ ModMetadata Mod::getMetadata() const {
     return m_impl->getMetadata();
 }
 
+std::string const& Mod::getIDRef() const {
+    return m_impl->getMetadataRef().getIDRef();
+}
+
+std::string const& Mod::getNameRef() const {
+    return m_impl->getMetadataRef().getNameRef();
+}
+
+std::string const& Mod::getDeveloperRef() const {
+    return m_impl->getMetadataRef().getDeveloperRef();
+}
+
+ModMetadata const& Mod::getMetadataRef() const {
+    return m_impl->getMetadataRef();
+}
+
 ghc::filesystem::path Mod::getTempDir() const {
     return m_impl->getTempDir();
 }
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <algorithm>
+#include <span>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace geode {
+    /**
+     * The graph algorithms behind the mod load order, kept apart from Mod
+     * so they can be run on any kind of node. Only depends on the standard
+     * library, so the test mods can build it on its own
+     */
+    namespace mod_graph {
+        template <class Node>
+        struct Order {
+            /**
+             * Every node whose dependencies could all be placed, with each
+             * node after all of its dependencies
+             */
+            std::vector<Node> order;
+            /**
+             * Every node left out of the order, because it's part of a cycle
+             * or depends on one
+             */
+            std::unordered_set<Node> blocked;
+        };
+
+        /**
+         * Sort the nodes so that each one comes after its dependencies,
+         * using Kahn's algorithm. Nodes that are ready at the same time keep
+         * the order they were given in
+         * @param forEachDependant Called with a node and a function to call
+         * with each of the node's dependants
+         */
+        template <class Node, class ForEachDependant>
+        Order<Node> sort(std::span<Node const> nodes, ForEachDependant&& forEachDependant) {
+            // an edge goes from a node to each of its dependants, so a node
+            // is ready once all of its dependencies have been placed
+            std::unordered_map<Node, size_t> pending;
+            for (auto node : nodes) {
+                pending.try_emplace(node, 0);
+                forEachDependant(node, [&](Node dependant) {
+                    pending[dependant] += 1;
+                });
+            }
+
+            Order<Node> res;
+            res.order.reserve(nodes.size());
+            for (auto node : nodes) {
+                if (pending[node] == 0) {
+                    res.order.push_back(node);
+                }
+            }
+            // the order doubles as the queue of ready nodes
+            for (size_t i = 0; i < res.order.size(); i++) {
+                forEachDependant(res.order[i], [&](Node dependant) {
+                    if (--pending[dependant] == 0) {
+                        res.order.push_back(dependant);
+                    }
+                });
+            }
+
+            for (auto node : nodes) {
+                if (pending[node] > 0) {
+                    res.blocked.insert(node);
+                }
+            }
+            return res;
+        }
+
+        /**
+         * Split the nodes into strongly connected components using Tarjan's
+         * algorithm, and get the component of each node. Nodes are in the
+         * same component exactly when they're part of the same cycle
+         * @param forEachDependency Called with a node and a function to call
+         * with each of the node's dependencies that are among the nodes
+         */
+        template <class Node, class ForEachDependency>
+        std::unordered_map<Node, size_t> components(
+            std::span<Node const> nodes, ForEachDependency&& forEachDependency
+        ) {
+            std::unordered_map<Node, size_t> index;
+            std::unordered_map<Node, size_t> lowLink;
+            std::unordered_map<Node, size_t> component;
+            std::vector<Node> stack;
+            std::unordered_set<Node> onStack;
+            size_t componentCount = 0;
+            auto visit = [&](auto& self, Node node) -> void {
+                auto order = index.size();
+                index[node] = order;
+                lowLink[node] = order;
+                stack.push_back(node);
+                onStack.insert(node);
+                forEachDependency(node, [&](Node dep) {
+                    if (!index.contains(dep)) {
+                        self(self, dep);
+                        lowLink[node] = std::min(lowLink[node], lowLink[dep]);
+                    }
+                    else if (onStack.contains(dep)) {
+                        lowLink[node] = std::min(lowLink[node], index[dep]);
+                    }
+                });
+                if (lowLink[node] != index[node])
+                    return;
+                Node member;
+                do {
+                    member = stack.back();
+                    stack.pop_back();
+                    onStack.erase(member);
+                    component[member] = componentCount;
+                } while (member != node);
+                componentCount += 1;
+            };
+            for (auto node : nodes) {
+                if (!index.contains(node)) {
+                    visit(visit, node);
+                }
+            }
+            return component;
+        }
+    }
+}
@@ -1,6 +1,7 @@
 #include "ModImpl.hpp"
 #include "LoaderImpl.hpp"
 #include "ModMetadataImpl.hpp"
+#include "ModMetadataCache.hpp"
 #include "about.hpp"
 
 #include <Geode/loader/Dirs.hpp>
@@ -34,8 +35,8 @@ Result<> Mod::Impl::setup() {
     m_saveDirPath = dirs::getModsSaveDir() / m_metadata.getID();
     (void) utils::file::createDirectoryAll(m_saveDirPath);
 
-    // always create temp dir for all mods, even if disabled, so resources can be loaded
-    GEODE_UNWRAP(this->createTempDir().expect("Unable to create temp dir: {error}"));
+    // the runtime directory has already been prepared by the loader, which
+    // extracts packages in parallel before setting mods up
 
     this->setupSettings();
     auto loadRes = this->loadData();
@@ -79,6 +80,10 @@ ModMetadata Mod::Impl::getMetadata() const {
     return m_metadata;
 }
 
+ModMetadata const& Mod::Impl::getMetadataRef() const {
+    return m_metadata;
+}
+
 #if defined(GEODE_EXPOSE_SECRET_INTERNALS_IN_HEADERS_DO_NOT_DEFINE_PLEASE)
 void Mod::Impl::setMetadata(ModMetadata const& metadata) {
     m_metadata = metadata;
@@ -129,11 +134,7 @@ bool Mod::Impl::canEnable() const {
 }
 
 bool Mod::Impl::needsEarlyLoad() const {
-    auto deps = m_dependants;
-    return getMetadata().needsEarlyLoad() ||
-        !deps.empty() && std::any_of(deps.begin(), deps.end(), [&](auto& item) {
-             return item->needsEarlyLoad();
-         });
+    return m_needsEarlyLoad || m_metadata.needsEarlyLoad();
 }
 
 bool Mod::Impl::wasSuccessfullyLoaded() const {
@@ -324,6 +325,13 @@ Result<> Mod::Impl::loadBinary() {
     if (m_binaryLoaded)
         return Ok();
 
+    auto wasEnabled = m_enabled;
+
+    if (m_deferExtraction) {
+        m_deferExtraction = false;
+        GEODE_UNWRAP(this->createTempDir().expect("Unable to create temp dir: {error}"));
+    }
+
     LoaderImpl::get()->provideNextMod(m_self);
 
     auto res = this->loadPlatformBinary();
@@ -364,6 +372,7 @@ Result<> Mod::Impl::loadBinary() {
     }
 
     m_enabled = true;
+    LoaderImpl::get()->m_mods.updateState(m_self, false, wasEnabled);
 
     ModStateEvent(m_self, ModEventType::Loaded).post();
     ModStateEvent(m_self, ModEventType::Enabled).post();
@@ -541,7 +550,26 @@ Result<> Mod::Impl::unpatch(Patch* patch) {
 
 // Misc.
 
-Result<> Mod::Impl::createTempDir() {
+static constexpr auto PACKAGE_STAMP_FILE = ".package-stamp";
+
+std::string Mod::Impl::getPackageStamp(ghc::filesystem::path const& package) {
+    auto info = ModMetadataCache::stat(package);
+    if (!info) {
+        return "";
+    }
+    return fmt::format("{}\n{}\n{}", package.string(), info->first, info->second);
+}
+
+bool Mod::Impl::isTempDirStale(ModMetadata const& metadata) {
+    auto stampPath = dirs::getModRuntimeDir() / metadata.getID() / PACKAGE_STAMP_FILE;
+    if (!ghc::filesystem::exists(stampPath)) {
+        return true;
+    }
+    auto stamp = file::readString(stampPath);
+    return !stamp || stamp.unwrap() != getPackageStamp(metadata.getPath());
+}
+
+Result<> Mod::Impl::createTempDir(file::Unzip* unzip) {
     // Check if temp dir already exists
     if (!m_tempDirName.string().empty()) {
         return Ok();
@@ -558,20 +586,44 @@ Result<> Mod::Impl::createTempDir() {
         return Err("Unable to create mods' runtime directory");
     }
 
-    // Create geode/temp/mod.id
     auto tempPath = tempDir / m_metadata.getID();
+
+    // Reuse the tree extracted on a previous launch if the package is the same
+    if (!isTempDirStale(m_metadata)) {
+        m_tempDirName = tempPath;
+        m_deferExtraction = false;
+        return Ok();
+    }
+
+    if (m_deferExtraction) {
+        return Ok();
+    }
+
+    // Create geode/unzipped/mod.id, clearing out files from an older version
+    std::error_code ec;
+    ghc::filesystem::remove_all(tempPath, ec);
     if (!file::createDirectoryAll(tempPath)) {
         return Err("Unable to create mod runtime directory");
     }
 
     // Unzip .geode file into temp dir
-    GEODE_UNWRAP_INTO(auto unzip, file::Unzip::create(m_metadata.getPath()));
-    if (!unzip.hasEntry(m_metadata.getBinaryName())) {
+    std::optional<file::Unzip> ownedUnzip;
+    if (!unzip) {
+        GEODE_UNWRAP_INTO(auto opened, file::Unzip::create(m_metadata.getPath()));
+        unzip = &ownedUnzip.emplace(std::move(opened));
+    }
+    if (!unzip->hasEntry(m_metadata.getBinaryName())) {
         return Err(
             fmt::format("Unable to find platform binary under the name \"{}\"", m_metadata.getBinaryName())
         );
     }
-    GEODE_UNWRAP(unzip.extractAllTo(tempPath));
+    GEODE_UNWRAP(unzip->extractAllTo(tempPath));
+
+    // The stamp is written last so an interrupted extraction is redone
+    GEODE_UNWRAP(
+        file::writeString(tempPath / PACKAGE_STAMP_FILE, getPackageStamp(m_metadata.getPath()))
+            .expect("Unable to write package stamp: {error}")
+    );
 
     // Mark temp dir creation as succesful
     m_tempDirName = tempPath;
@@ -579,6 +631,34 @@ Result<> Mod::Impl::createTempDir() {
     return Ok();
 }
 
+void Mod::Impl::extractLogo() {
+    if (!m_deferExtraction || m_logoExtracted) {
+        return;
+    }
+    m_logoExtracted = true;
+
+    auto tempPath = dirs::getModRuntimeDir() / m_metadata.getID();
+    if (!file::createDirectoryAll(tempPath)) {
+        log::warn("Unable to create runtime directory for {}", m_metadata.getID());
+        return;
+    }
+    auto unzip = file::Unzip::create(m_metadata.getPath());
+    if (!unzip) {
+        log::warn("Unable to open package of {}: {}", m_metadata.getID(), unzip.unwrapErr());
+        return;
+    }
+    // a leftover tree from an older version may have a logo the new one lacks
+    std::error_code ec;
+    ghc::filesystem::remove(tempPath / "logo.png", ec);
+    auto& zip = unzip.unwrap();
+    if (zip.hasEntry("logo.png")) {
+        auto res = zip.extractTo("logo.png", tempPath / "logo.png");
+        if (!res) {
+            log::warn("Unable to extract logo of {}: {}", m_metadata.getID(), res.unwrapErr());
+        }
+    }
+}
+
 ghc::filesystem::path Mod::Impl::getConfigDir(bool create) const {
     auto dir = dirs::getModConfigDir() / m_metadata.getID();
     if (create) {
@@ -617,6 +697,12 @@ ModJson Mod::Impl::getRuntimeInfo() const {
     obj["temp-dir"] = this->getTempDir();
     obj["save-dir"] = this->getSaveDir();
     obj["config-dir"] = this->getConfigDir(false);
+    auto queue = LoaderImpl::get()->m_mainThreadQueue.getModStats(m_self);
+    json::Value queueObj = json::Object();
+    queueObj["depth"] = static_cast<double>(queue.depth);
+    queueObj["ran"] = static_cast<double>(queue.ran);
+    queueObj["time-us"] = static_cast<double>(queue.time.count());
+    obj["main-thread-queue"] = queueObj;
     json["runtime"] = obj;
 
     return json;
@@ -654,7 +740,7 @@ Mod* Loader::Impl::createInternalMod() {
     }
     mod->m_impl->m_binaryLoaded = true;
     mod->m_impl->m_enabled = true;
-    m_mods.insert({ mod->getID(), mod });
+    m_mods.add(mod);
     return mod;
 }
 
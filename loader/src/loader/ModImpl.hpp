@@ -1,6 +1,7 @@
 #pragma once
 
 #include <json.hpp>
+#include <atomic>
 
 namespace geode {
     class Mod::Impl {
@@ -34,6 +35,17 @@ namespace geode {
          * Mod temp directory name
          */
         ghc::filesystem::path m_tempDirName;
+        /**
+         * Whether extracting the mod's package has been put off until it's 
+         * loaded. Set for disabled mods whose runtime directory is missing 
+         * or out of date
+         */
+        bool m_deferExtraction = false;
+        /**
+         * Whether the logo of a mod with deferred extraction has been 
+         * extracted on its own
+         */
+        bool m_logoExtracted = false;
         /**
          * Mod save directory name
          */
@@ -44,6 +56,11 @@ namespace geode {
          * when their dependency is disabled.
          */
         std::vector<Mod*> m_dependants;
+        /**
+         * Whether this mod or any mod depending on it needs to be loaded 
+         * early. Computed once when the mod graph is built
+         */
+        bool m_needsEarlyLoad = false;
         /**
          * Saved values
          */
@@ -61,7 +78,11 @@ namespace geode {
          * Whether the mod resources are loaded or not
          */
         bool m_resourcesLoaded = false;
-
+        /**
+         * Minimum severity of the logs kept from this mod, or -1 if the 
+         * global minimum applies
+         */
+        std::atomic_int m_minLogSeverity = -1;
 
         ModRequestedAction m_requestedAction = ModRequestedAction::None;
 
@@ -72,7 +93,29 @@ namespace geode {
 
         Result<> loadPlatformBinary();
         Result<> unloadPlatformBinary();
-        Result<> createTempDir();
+        /**
+         * Extract the mod's package into its runtime directory, unless the
+         * tree extracted on a previous launch is still up-to-date
+         * @param unzip An already opened handle to the package, if the caller
+         * has one. Otherwise the package is opened on demand
+         */
+        Result<> createTempDir(utils::file::Unzip* unzip = nullptr);
+        /**
+         * Extract just the logo of a mod whose extraction has been deferred, 
+         * so it can be shown in the mods list
+         */
+        void extractLogo();
+
+        /**
+         * Get the stamp identifying the package a runtime directory was
+         * extracted from, or an empty string if the package can't be read
+         */
+        static std::string getPackageStamp(ghc::filesystem::path const& package);
+        /**
+         * Whether the runtime directory for this package is missing or was
+         * extracted from a different version of the package
+         */
+        static bool isTempDirStale(ModMetadata const& metadata);
 
         void setupSettings();
 
@@ -91,6 +134,7 @@ namespace geode {
         bool needsEarlyLoad() const;
         bool wasSuccessfullyLoaded() const;
         ModMetadata getMetadata() const;
+        ModMetadata const& getMetadataRef() const;
         ghc::filesystem::path getTempDir() const;
         ghc::filesystem::path getBinaryPath() const;
 
@@ -0,0 +1,155 @@
+#include "ModMetadataCache.hpp"
+#include "ModMetadataImpl.hpp"
+
+#include <Geode/loader/Dirs.hpp>
+#include <Geode/loader/Log.hpp>
+#include <Geode/utils/file.hpp>
+#include <unordered_set>
+
+using namespace geode::prelude;
+
+ghc::filesystem::path ModMetadataCache::getPath() {
+    return dirs::getGeodeDir() / "mods-cache.json";
+}
+
+std::optional<std::pair<uintmax_t, std::string>> ModMetadataCache::stat(ghc::filesystem::path const& path) {
+    std::error_code ec;
+    auto size = ghc::filesystem::file_size(path, ec);
+    if (ec) {
+        return std::nullopt;
+    }
+    auto mtime = ghc::filesystem::last_write_time(path, ec);
+    if (ec) {
+        return std::nullopt;
+    }
+    // stored as a string since the tick count doesn't fit in a json number
+    return std::make_pair(size, std::to_string(mtime.time_since_epoch().count()));
+}
+
+void ModMetadataCache::load() {
+    m_entries.clear();
+    // the counters describe a single scan, so a refresh starts them over
+    m_hits = 0;
+    m_misses = 0;
+
+    if (!ghc::filesystem::exists(getPath())) {
+        return;
+    }
+
+    auto res = file::readJson(getPath());
+    if (!res) {
+        log::warn("Unable to read mod metadata cache, ignoring it: {}", res.unwrapErr());
+        return;
+    }
+    auto json = res.unwrap();
+
+    try {
+        if (!json.contains("version") || json["version"].as_int() != VERSION) {
+            log::debug("Mod metadata cache is outdated, ignoring it");
+            return;
+        }
+        for (auto& [path, value] : json["mods"].as_object()) {
+            Entry entry;
+            entry.size = static_cast<uintmax_t>(value["size"].as_double());
+            entry.mtime = value["mtime"].as_string();
+            entry.json = value["mod.json"];
+            for (auto& [name, data] : value["special-files"].as_object()) {
+                entry.specialFiles.emplace_back(name, data.as_string());
+            }
+            m_entries.insert({ path, std::move(entry) });
+        }
+    }
+    catch (std::exception& err) {
+        log::warn("Mod metadata cache is corrupted, ignoring it: {}", err.what());
+        m_entries.clear();
+    }
+}
+
+Result<> ModMetadataCache::save() const {
+    json::Value mods = json::Object();
+    for (auto& [path, entry] : m_entries) {
+        json::Value specialFiles = json::Object();
+        for (auto& [name, data] : entry.specialFiles) {
+            specialFiles[name] = data;
+        }
+        json::Value obj = json::Object();
+        obj["size"] = static_cast<double>(entry.size);
+        obj["mtime"] = entry.mtime;
+        obj["mod.json"] = entry.json;
+        obj["special-files"] = specialFiles;
+        mods[path] = obj;
+    }
+    json::Value json = json::Object();
+    json["version"] = VERSION;
+    json["mods"] = mods;
+    return file::writeString(getPath(), json.dump());
+}
+
+std::optional<ModMetadata> ModMetadataCache::get(ghc::filesystem::path const& path) const {
+    auto it = m_entries.find(path.string());
+    auto info = stat(path);
+    if (it == m_entries.end() || !info ||
+        it->second.size != info->first || it->second.mtime != info->second) {
+        m_misses += 1;
+        return std::nullopt;
+    }
+    auto& entry = it->second;
+
+    // the mod.json is still validated, which is cheap next to opening the zip
+    auto res = ModMetadata::create(entry.json);
+    if (!res) {
+        m_misses += 1;
+        return std::nullopt;
+    }
+    auto metadata = res.unwrap();
+    auto& impl = ModMetadataImpl::getImpl(metadata);
+    impl.m_path = path;
+    for (auto& [name, target] : impl.getSpecialFiles()) {
+        for (auto& [cachedName, data] : entry.specialFiles) {
+            if (cachedName == name) {
+                *target = data;
+            }
+        }
+    }
+
+    m_hits += 1;
+    return metadata;
+}
+
+void ModMetadataCache::store(ModMetadata const& metadata) {
+    auto path = metadata.getPath();
+    auto info = stat(path);
+    if (!info) {
+        return;
+    }
+    Entry entry;
+    entry.size = info->first;
+    entry.mtime = info->second;
+    entry.json = metadata.getRawJSON();
+
+    auto copy = metadata;
+    for (auto& [name, data] : ModMetadataImpl::getImpl(copy).getSpecialFiles()) {
+        if (*data) {
+            entry.specialFiles.emplace_back(name, data->value());
+        }
+    }
+    m_entries.insert_or_assign(path.string(), std::move(entry));
+}
+
+void ModMetadataCache::retain(std::vector<ghc::filesystem::path> const& packages) {
+    std::unordered_set<std::string> keep;
+    for (auto& path : packages) {
+        keep.insert(path.string());
+    }
+    std::erase_if(m_entries, [&](auto const& pair) {
+        return !keep.contains(pair.first);
+    });
+}
+
+size_t ModMetadataCache::getHits() const {
+    return m_hits;
+}
+
+size_t ModMetadataCache::getMisses() const {
+    return m_misses;
+}
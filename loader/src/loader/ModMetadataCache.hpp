@@ -0,0 +1,71 @@
+#pragma once
+
+#include <Geode/loader/ModMetadata.hpp>
+#include <Geode/utils/Result.hpp>
+#include <ghc/fs_fwd.hpp>
+#include <json.hpp>
+#include <atomic>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace geode {
+    /**
+     * Loader-owned cache of the metadata of installed .geode packages, so
+     * packages that haven't changed since the last launch don't need to be
+     * opened just to re-read their mod.json and special files. Entries are
+     * keyed by package path and invalidated when its size or modification
+     * time changes
+     */
+    class ModMetadataCache final {
+    public:
+        /**
+         * Bump whenever the layout of the cache file changes; caches with a
+         * different version are discarded
+         */
+        static constexpr int VERSION = 1;
+
+    private:
+        struct Entry {
+            uintmax_t size;
+            std::string mtime;
+            ModJson json;
+            std::vector<std::pair<std::string, std::string>> specialFiles;
+        };
+
+        std::unordered_map<std::string, Entry> m_entries;
+        mutable std::atomic_size_t m_hits = 0;
+        mutable std::atomic_size_t m_misses = 0;
+
+    public:
+        /**
+         * Get the size and modification time of a package, which together
+         * identify its version
+         */
+        static std::optional<std::pair<uintmax_t, std::string>> stat(ghc::filesystem::path const& path);
+
+        static ghc::filesystem::path getPath();
+
+        /**
+         * Read the cache from disk. A missing, outdated or corrupted cache
+         * file results in an empty cache. Also resets the hit and miss counts
+         */
+        void load();
+        Result<> save() const;
+
+        /**
+         * Get the cached metadata for a package if it hasn't changed since it
+         * was stored. Safe to call from multiple threads at once as long as
+         * nothing is stored concurrently
+         */
+        std::optional<ModMetadata> get(ghc::filesystem::path const& path) const;
+        void store(ModMetadata const& metadata);
+        /**
+         * Drop entries for every package not in the list
+         */
+        void retain(std::vector<ghc::filesystem::path> const& packages);
+
+        size_t getHits() const;
+        size_t getMisses() const;
+    };
+}
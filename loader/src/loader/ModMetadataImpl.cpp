@@ -402,6 +402,38 @@ std::vector<std::pair<std::string, Setting>> ModMetadata::getSettings() const {
     return m_impl->m_settings;
 }
 
+std::string const& ModMetadata::getIDRef() const {
+    return m_impl->m_id;
+}
+
+std::string const& ModMetadata::getNameRef() const {
+    return m_impl->m_name;
+}
+
+std::string const& ModMetadata::getDeveloperRef() const {
+    return m_impl->m_developer;
+}
+
+std::optional<std::string> const& ModMetadata::getDescriptionRef() const {
+    return m_impl->m_description;
+}
+
+std::optional<std::string> const& ModMetadata::getDetailsRef() const {
+    return m_impl->m_details;
+}
+
+std::vector<ModMetadata::Dependency> const& ModMetadata::getDependenciesRef() const {
+    return m_impl->m_dependencies;
+}
+
+std::vector<ModMetadata::Incompatibility> const& ModMetadata::getIncompatibilitiesRef() const {
+    return m_impl->m_incompatibilities;
+}
+
+std::vector<std::pair<std::string, Setting>> const& ModMetadata::getSettingsRef() const {
+    return m_impl->m_settings;
+}
+
 bool ModMetadata::needsEarlyLoad() const {
     return m_impl->m_needsEarlyLoad;
 }
@@ -0,0 +1,101 @@
+#include "ModRegistry.hpp"
+
+#include <algorithm>
+
+using namespace geode::prelude;
+
+std::string_view ModRegistry::intern(std::string_view id) {
+    return *m_ids.emplace(id).first;
+}
+
+void ModRegistry::add(Mod* mod) {
+    auto id = this->intern(mod->getIDRef());
+    std::lock_guard lock(m_mutex);
+    if (auto old = this->get(id)) {
+        this->erase(old);
+    }
+    m_mods.push_back(mod);
+    m_byID.insert({ id, mod });
+    if (mod->isLoaded()) {
+        m_loadedCount += 1;
+    }
+    if (mod->isEnabled()) {
+        m_enabledCount += 1;
+    }
+}
+
+void ModRegistry::remove(Mod* mod) {
+    std::lock_guard lock(m_mutex);
+    this->erase(mod);
+}
+
+void ModRegistry::erase(Mod* mod) {
+    auto it = std::find(m_mods.begin(), m_mods.end(), mod);
+    if (it == m_mods.end()) {
+        return;
+    }
+    m_mods.erase(it);
+    m_byID.erase(mod->getIDRef());
+    if (mod->isLoaded()) {
+        m_loadedCount -= 1;
+    }
+    if (mod->isEnabled()) {
+        m_enabledCount -= 1;
+    }
+}
+
+void ModRegistry::clear() {
+    std::lock_guard lock(m_mutex);
+    m_mods.clear();
+    m_byID.clear();
+    m_loadedCount = 0;
+    m_enabledCount = 0;
+}
+
+std::unique_lock<std::mutex> ModRegistry::lock() const {
+    return std::unique_lock(m_mutex);
+}
+
+Mod* ModRegistry::get(std::string_view id) const {
+    auto it = m_byID.find(id);
+    return it != m_byID.end() ? it->second : nullptr;
+}
+
+bool ModRegistry::contains(std::string_view id) const {
+    return m_byID.contains(id);
+}
+
+std::span<Mod* const> ModRegistry::all() const {
+    return m_mods;
+}
+
+size_t ModRegistry::size() const {
+    return m_mods.size();
+}
+
+std::vector<Mod*>::const_iterator ModRegistry::begin() const {
+    return m_mods.begin();
+}
+
+std::vector<Mod*>::const_iterator ModRegistry::end() const {
+    return m_mods.end();
+}
+
+size_t ModRegistry::getLoadedCount() const {
+    return m_loadedCount;
+}
+
+size_t ModRegistry::getEnabledCount() const {
+    return m_enabledCount;
+}
+
+void ModRegistry::updateState(Mod* mod, bool wasLoaded, bool wasEnabled) {
+    // unregistered mods aren't part of the counters
+    if (this->get(mod->getIDRef()) != mod) {
+        return;
+    }
+    m_loadedCount += mod->isLoaded();
+    m_loadedCount -= wasLoaded;
+    m_enabledCount += mod->isEnabled();
+    m_enabledCount -= wasEnabled;
+}
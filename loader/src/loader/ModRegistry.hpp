@@ -0,0 +1,77 @@
+#pragma once
+
+#include <Geode/loader/Mod.hpp>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace geode {
+    /**
+     * The set of mods known to the loader. Mods are kept in a contiguous
+     * array in the order they were added so they can be iterated and handed
+     * out as a view without allocating, and are looked up through their
+     * interned ID. The amount of loaded and enabled mods is tracked as mods
+     * change state so it doesn't have to be counted every time it's needed.
+     * Only the main thread may change the registry; other threads have to 
+     * hold lock() while they look mods up or use them
+     */
+    class ModRegistry final {
+    private:
+        std::vector<Mod*> m_mods;
+        // the keys point into m_ids, which never shrinks so they stay valid
+        std::unordered_map<std::string_view, Mod*> m_byID;
+        std::unordered_set<std::string> m_ids;
+        size_t m_loadedCount = 0;
+        size_t m_enabledCount = 0;
+        // held by the main thread while adding or removing mods
+        mutable std::mutex m_mutex;
+
+        void erase(Mod* mod);
+
+    public:
+        /**
+         * Intern a mod ID. The returned view stays valid for the lifetime
+         * of the registry
+         */
+        std::string_view intern(std::string_view id);
+
+        /**
+         * Add a mod to the registry, replacing any mod with the same ID
+         */
+        void add(Mod* mod);
+        /**
+         * Remove a mod from the registry. Does not delete the mod
+         */
+        void remove(Mod* mod);
+        void clear();
+
+        /**
+         * Keep mods from being added or removed while the lock is held. Mods
+         * are only deleted after they've been removed, so a mod found through 
+         * the registry stays alive until the lock is released
+         */
+        std::unique_lock<std::mutex> lock() const;
+
+        Mod* get(std::string_view id) const;
+        bool contains(std::string_view id) const;
+
+        std::span<Mod* const> all() const;
+        size_t size() const;
+        std::vector<Mod*>::const_iterator begin() const;
+        std::vector<Mod*>::const_iterator end() const;
+
+        size_t getLoadedCount() const;
+        size_t getEnabledCount() const;
+        /**
+         * Update the cached counters after a mod has been loaded or enabled
+         * @param mod The mod whose state changed
+         * @param wasLoaded Whether the mod was loaded before the change
+         * @param wasEnabled Whether the mod was enabled before the change
+         */
+        void updateState(Mod* mod, bool wasLoaded, bool wasEnabled);
+    };
+}
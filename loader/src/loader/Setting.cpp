@@ -237,6 +237,10 @@ std::string SettingValue::getModID() const {
     return m_modID;
 }
 
+std::string const& SettingValue::getKeyRef() const {
+    return m_key;
+}
+
 void SettingValue::valueChanged() {
     // this is actually p neat because now if the mod gets disabled this wont 
     // post the event so that side-effect is automatically handled :3
@@ -402,10 +406,10 @@ SettingChangedEvent::SettingChangedEvent(Mod* mod, SettingValue* value)
 // SettingChangedFilter
 
 ListenerResult SettingChangedFilter::handle(
-    utils::MiniFunction<Callback> fn, SettingChangedEvent* event
+    utils::MiniFunction<Callback> const& fn, SettingChangedEvent* event
 ) {
-    if (m_modID == event->mod->getID() &&
-        (!m_targetKey || m_targetKey.value() == event->value->getKey())
+    if (m_modID == event->mod->getIDRef() &&
+        (!m_targetKey || m_targetKey.value() == event->value->getKeyRef())
     ) {
         fn(event->value);
     }
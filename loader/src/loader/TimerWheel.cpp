@@ -0,0 +1,139 @@
+#include "TimerWheel.hpp"
+
+using namespace geode::prelude;
+
+TimerHandle::TimerHandle(std::shared_ptr<std::atomic_bool> cancelled)
+  : m_cancelled(std::move(cancelled)) {}
+
+void TimerHandle::cancel() {
+    if (m_cancelled) {
+        *m_cancelled = true;
+    }
+}
+
+bool TimerHandle::isCancelled() const {
+    return !m_cancelled || *m_cancelled;
+}
+
+TimerWheel::TimerWheel(MainThreadQueue& queue) : m_queue(queue) {}
+
+uint64_t TimerWheel::toTick(Clock::time_point time) const {
+    if (time <= m_start) {
+        return 0;
+    }
+    return std::chrono::duration_cast<std::chrono::milliseconds>(time - m_start).count();
+}
+
+void TimerWheel::insert(std::unique_ptr<Timer> timer) {
+    auto delta = timer->deadline - m_now;
+    for (size_t level = 0; level < LEVELS; level++) {
+        auto span = uint64_t(1) << (SLOT_BITS * (level + 1));
+        if (delta < span || level == LEVELS - 1) {
+            // timers too far off for the last level are parked in the last 
+            // slot it can reach and reinserted when that is cascaded
+            auto at = delta < span ? timer->deadline : m_now + span - 1;
+            auto slot = (at >> (SLOT_BITS * level)) & (SLOTS - 1);
+            m_levels[level][slot].push_back(std::move(timer));
+            return;
+        }
+    }
+}
+
+void TimerWheel::cascade(size_t level) {
+    auto& slot = m_levels[level][(m_now >> (SLOT_BITS * level)) & (SLOTS - 1)];
+    auto timers = std::move(slot);
+    slot.clear();
+    for (auto& timer : timers) {
+        this->insert(std::move(timer));
+    }
+}
+
+void TimerWheel::fire(Slot& slot) {
+    auto timers = std::move(slot);
+    slot.clear();
+    for (auto& timer : timers) {
+        if (*timer->cancelled) {
+            m_count -= 1;
+            continue;
+        }
+        if (timer->interval) {
+            m_queue.push([func = timer->func, cancelled = timer->cancelled]() {
+                if (!*cancelled) func();
+            }, timer->mod);
+            timer->deadline = m_now + timer->interval;
+            this->insert(std::move(timer));
+        }
+        else {
+            m_queue.push([func = std::move(timer->func), cancelled = timer->cancelled]() {
+                if (!*cancelled) func();
+            }, timer->mod);
+            m_count -= 1;
+        }
+    }
+}
+
+TimerHandle TimerWheel::schedule(
+    std::chrono::milliseconds delay, std::chrono::milliseconds interval,
+    ScheduledFunction func, Mod* mod
+) {
+    auto cancelled = std::make_shared<std::atomic_bool>(false);
+    // the deadline is taken now so the time spent waiting to be added to the 
+    // wheel counts towards the delay
+    auto timer = std::make_unique<Timer>(Timer {
+        this->toTick(Clock::now() + delay),
+        static_cast<uint64_t>(std::max<int64_t>(interval.count(), 0)),
+        std::move(func),
+        mod,
+        cancelled
+    });
+    m_queue.push([this, timer = std::move(timer)]() mutable {
+        // timers that are already due fire on the next tick
+        timer->deadline = std::max(timer->deadline, m_now + 1);
+        m_count += 1;
+        this->insert(std::move(timer));
+    }, mod);
+    return TimerHandle(cancelled);
+}
+
+uint64_t TimerWheel::nextTick(uint64_t target) const {
+    // the slots of a level are visited once every 64^level ticks, so the 
+    // next tick anything happens on is the first visit of a non-empty slot 
+    // on any level. A level with no non-empty slot in a whole rotation is 
+    // empty
+    auto next = target;
+    for (size_t level = 0; level < LEVELS; level++) {
+        auto shift = SLOT_BITS * level;
+        auto tick = ((m_now >> shift) + 1) << shift;
+        for (size_t i = 0; i < SLOTS && tick < next; i++, tick += uint64_t(1) << shift) {
+            if (!m_levels[level][(tick >> shift) & (SLOTS - 1)].empty()) {
+                next = tick;
+                break;
+            }
+        }
+    }
+    return next;
+}
+
+void TimerWheel::update() {
+    auto target = this->toTick(Clock::now());
+    while (m_now < target) {
+        m_now = this->nextTick(target);
+        // move timers down from every level that wraps around on this tick, 
+        // highest first so they can keep falling through the levels below
+        size_t wrapped = 0;
+        while (
+            wrapped + 1 < LEVELS &&
+            ((m_now >> (SLOT_BITS * (wrapped + 1))) << (SLOT_BITS * (wrapped + 1))) == m_now
+        ) {
+            wrapped += 1;
+        }
+        for (size_t level = wrapped; level > 0; level--) {
+            this->cascade(level);
+        }
+        this->fire(m_levels[0][m_now & (SLOTS - 1)]);
+    }
+}
+
+size_t TimerWheel::getCount() const {
+    return m_count;
+}
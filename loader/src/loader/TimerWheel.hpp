@@ -0,0 +1,74 @@
+#pragma once
+
+#include "MainThreadQueue.hpp"
+
+#include <Geode/loader/Loader.hpp>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+namespace geode {
+    /**
+     * Hierarchical timer wheel for functions scheduled with a delay. Ticks 
+     * are a millisecond; the first level has a slot for each of the next 64 
+     * ticks, and each level above covers 64 times the span of the one below. 
+     * Timers are moved down a level whenever the level below wraps around, 
+     * so adding a timer and firing it are both O(1) regardless of how many 
+     * are pending. Fired functions are handed to the main thread queue so 
+     * they share its frame budget
+     */
+    class TimerWheel final {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        static constexpr size_t SLOT_BITS = 6;
+        static constexpr size_t SLOTS = 1 << SLOT_BITS;
+        static constexpr size_t LEVELS = 4;
+
+    private:
+        struct Timer {
+            uint64_t deadline;
+            // zero for timers that only run once
+            uint64_t interval;
+            ScheduledFunction func;
+            Mod* mod;
+            std::shared_ptr<std::atomic_bool> cancelled;
+        };
+        using Slot = std::vector<std::unique_ptr<Timer>>;
+
+        MainThreadQueue& m_queue;
+        Clock::time_point m_start = Clock::now();
+        uint64_t m_now = 0;
+        std::array<std::array<Slot, SLOTS>, LEVELS> m_levels;
+        size_t m_count = 0;
+
+        uint64_t toTick(Clock::time_point time) const;
+        void insert(std::unique_ptr<Timer> timer);
+        void cascade(size_t level);
+        void fire(Slot& slot);
+        uint64_t nextTick(uint64_t target) const;
+
+    public:
+        TimerWheel(MainThreadQueue& queue);
+
+        /**
+         * Schedule a function. Safe to call from any thread, as the timer is 
+         * added to the wheel through the main thread queue
+         */
+        TimerHandle schedule(
+            std::chrono::milliseconds delay, std::chrono::milliseconds interval,
+            ScheduledFunction func, Mod* mod
+        );
+        /**
+         * Fire every timer that has expired. Must be called from the main 
+         * thread, once per frame. Ticks where nothing is due are skipped, so 
+         * catching up after a long frame only costs as much as the timers 
+         * that have to be fired or moved down
+         */
+        void update();
+
+        size_t getCount() const;
+    };
+}
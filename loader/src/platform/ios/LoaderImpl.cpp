@@ -17,7 +17,7 @@ void Loader::Impl::platformMessageBox(char const* title, std::string const& info
 
 void Loader::Impl::logConsoleMessageWithSeverity(std::string const& msg, Severity severity) {
     if (m_platformConsoleOpen) {
-        std::cout << msg << "\n" << std::flush;
+        std::cout << msg << "\n";
     }
 }
 
@@ -28,7 +28,7 @@ void Loader::Impl::logConsoleMessageWithSeverity(std::string const& msg, Severit
         }
         auto newMsg = "\033[1;" + std::to_string(colorcode) + "m" + msg.substr(0, 8) + "\033[0m" + msg.substr(8);
 
-        std::cout << newMsg << "\n" << std::flush;
+        std::cout << newMsg << "\n";
     }
 }
 
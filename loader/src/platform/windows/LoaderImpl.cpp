@@ -33,9 +33,9 @@ void Loader::Impl::logConsoleMessageWithSeverity(std::string const& msg, Severit
             auto const colorStr = fmt::format("\x1b[38;5;{}m", color);
             auto const newMsg = fmt::format("{}{}\x1b[0m{}", colorStr, msg.substr(0, 8), msg.substr(8));
 
-            std::cout << newMsg << "\n" << std::flush;
+            std::cout << newMsg << "\n";
         } else {
-            std::cout << msg << "\n" << std::flush;
+            std::cout << msg << "\n";
         }
     }
 }
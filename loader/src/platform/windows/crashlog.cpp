@@ -83,7 +83,7 @@ static HMODULE handleFromAddress(void const* addr) {
 
 static Mod* modFromAddress(PVOID exceptionAddress) {
     auto modulePath = getModuleName(handleFromAddress(exceptionAddress), true);
-    for (auto& mod : Loader::get()->getAllMods()) {
+    for (auto& mod : Loader::get()->getAllModsView()) {
         if (mod->getBinaryPath() == modulePath) {
             return mod;
         }
@@ -8,6 +8,7 @@
 #include <Geode/ui/GeodeUI.hpp>
 #include <Geode/ui/MDPopup.hpp>
 #include <Geode/utils/web.hpp>
+#include <loader/ModImpl.hpp>
 
 void geode::openModsList() {
     ModListLayer::scene();
@@ -73,6 +74,9 @@ CCNode* geode::createDefaultLogo(CCSize const& size) {
 }
 
 CCNode* geode::createModLogo(Mod* mod, CCSize const& size) {
+    if (mod != Mod::get()) {
+        ModImpl::getImpl(mod)->extractLogo();
+    }
     CCNode* spr = mod == Mod::get() ?
         CCSprite::createWithSpriteFrameName("geode-logo.png"_spr) :
         CCSprite::create(fmt::format("{}/logo.png", mod->getID()).c_str());
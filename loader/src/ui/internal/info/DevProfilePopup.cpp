@@ -15,7 +15,7 @@ bool DevProfilePopup::setup(std::string const& developer) {
     auto items = CCArray::create();
 
     // installed mods
-    for (auto& mod : Loader::get()->getAllMods()) {
+    for (auto& mod : Loader::get()->getAllModsView()) {
         if (mod->getDeveloper() == developer) {
             auto cell = ModCell::create(
                 mod, nullptr, ModListDisplay::Concise, { 358.f, 40.f }
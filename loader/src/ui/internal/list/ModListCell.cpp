@@ -252,16 +252,7 @@ void ModCell::updateState() {
         m_enableToggle->m_onButton->setOpacity(unresolved ? 100 : 255);
         m_enableToggle->m_onButton->setColor(unresolved ? cc3x(155) : cc3x(255));
     }
-    bool hasProblems = false;
-    for (auto const& item : Loader::get()->getProblems()) {
-        if (!std::holds_alternative<Mod*>(item.cause) ||
-            std::get<Mod*>(item.cause) != m_mod ||
-            item.type <= LoadProblem::Type::Recommendation)
-            continue;
-        hasProblems = true;
-        break;
-    }
-    m_unresolvedExMark->setVisible(hasProblems);
+    m_unresolvedExMark->setVisible(Loader::get()->getErrorCount(m_mod) > 0);
 }
 
 bool ModCell::init(
@@ -558,7 +549,7 @@ bool ProblemsCell::init(
 
     LoadProblem::Type problemType = LoadProblem::Type::Unknown;
     // iterate problems to find the most important severity
-    for (auto const& problem : Loader::get()->getProblems()) {
+    for (auto const& problem : Loader::get()->getProblemsView()) {
         if (problemType < problem.type)
             problemType = problem.type;
         // already found the most important one (error)
@@ -36,6 +36,14 @@ static std::optional<int> fuzzyMatch(std::string const& kw, std::string const& s
     return std::nullopt;
 }
 
+static std::optional<int> fuzzyMatch(std::string const& kw, std::optional<std::string> const& str) {
+    int score;
+    if (fts::fuzzy_match(kw.c_str(), str ? str->c_str() : "", score)) {
+        return score;
+    }
+    return std::nullopt;
+}
+
 #define WEIGHTED_MATCH(str_, weight_) \
     if (auto match = fuzzyMatch(query.keywords.value(), str_)) {\
         weighted += match.value() * weight_;                    \
@@ -62,11 +70,11 @@ static std::optional<int> queryMatchKeywords(
     // fuzzy match keywords
     if (query.keywords) {
         bool someMatched = false;
-        WEIGHTED_MATCH_MAX(metadata.getName(), 2);
-        WEIGHTED_MATCH_MAX(metadata.getID(), 1);
-        WEIGHTED_MATCH_MAX(metadata.getDeveloper(), 0.5);
-        WEIGHTED_MATCH_MAX(metadata.getDetails().value_or(""), 0.05);
-        WEIGHTED_MATCH_MAX(metadata.getDescription().value_or(""), 0.2);
+        WEIGHTED_MATCH_MAX(metadata.getNameRef(), 2);
+        WEIGHTED_MATCH_MAX(metadata.getIDRef(), 1);
+        WEIGHTED_MATCH_MAX(metadata.getDeveloperRef(), 0.5);
+        WEIGHTED_MATCH_MAX(metadata.getDetailsRef(), 0.05);
+        WEIGHTED_MATCH_MAX(metadata.getDescriptionRef(), 0.2);
         if (!someMatched) {
             return std::nullopt;
         }
@@ -77,7 +85,7 @@ static std::optional<int> queryMatchKeywords(
         // sorted, at least enough so that if you're scrolling it based on 
         // alphabetical order you will find the part you're looking for easily 
         // so it's fine
-        return static_cast<int>(-tolower(metadata.getName()[0]));
+        return static_cast<int>(-tolower(metadata.getNameRef()[0]));
     }
 
     // if the weight is relatively small we can ignore it
@@ -93,23 +101,23 @@ static std::optional<int> queryMatch(ModListQuery const& query, Mod* mod) {
     // Only checking keywords makes sense for mods since their 
     // platform always matches, they are always visible and they don't 
     // currently list their tags
-    return queryMatchKeywords(query, mod->getMetadata());
+    return queryMatchKeywords(query, mod->getMetadataRef());
 }
 
 static std::optional<int> queryMatch(ModListQuery const& query, IndexItemHandle item) {
     // if no force visibility was provided and item is already installed, don't show it
-    if (!query.forceVisibility && Loader::get()->isModInstalled(item->getMetadata().getID())) {
+    if (!query.forceVisibility && Loader::get()->isModInstalled(item->getMetadataRef().getIDRef())) {
         return std::nullopt;
     }
     // make sure all tags match
     for (auto& tag : query.tags) {
-        if (!item->getTags().count(tag)) {
+        if (!item->getTagsRef().count(tag)) {
             return std::nullopt;
         }
     }
     // make sure at least some platform matches
     if (!ranges::contains(query.platforms, [item](PlatformID id) {
-        return item->getAvailablePlatforms().count(id);
+        return item->getAvailablePlatformsRef().count(id);
     })) {
         return std::nullopt;
     }
@@ -118,17 +126,17 @@ static std::optional<int> queryMatch(ModListQuery const& query, IndexItemHandle
     if (!query.forceInvalid && !canInstall) {
         log::warn(
             "Removing {} from the list because it cannot be installed: {}",
-            item->getMetadata().getID(),
+            item->getMetadataRef().getIDRef(),
             canInstall.unwrapErr()
         );
         return std::nullopt;
     }
     // otherwise match keywords
-    if (auto match = queryMatchKeywords(query, item->getMetadata())) {
+    if (auto match = queryMatchKeywords(query, item->getMetadataRef())) {
         auto weighted = match.value();
         // add extra weight on tag matches
         if (query.keywords) {
-            WEIGHTED_MATCH_ADD(ranges::join(item->getTags(), " "), 1.4);
+            WEIGHTED_MATCH_ADD(ranges::join(item->getTagsRef(), " "), 1.4);
         }
         // add extra weight to featured items to keep power consolidated in the 
         // hands of the rich Geode bourgeoisie
@@ -157,7 +165,7 @@ CCArray* ModListLayer::createModCells(ModListType type, ModListQuery const& quer
         default:
         case ModListType::Installed: {
             // problems first
-            if (!Loader::get()->getProblems().empty()) {
+            if (!Loader::get()->getProblemsView().empty()) {
                 mods->addObject(ProblemsCell::create(this, m_display, this->getCellSize()));
             }
 
@@ -169,18 +177,18 @@ CCArray* ModListLayer::createModCells(ModListType type, ModListQuery const& quer
             // newly installed
             for (auto const& item : Index::get()->getItems()) {
                 if (!item->isInstalled() ||
-                    Loader::get()->isModInstalled(item->getMetadata().getID()) ||
-                    Loader::get()->isModLoaded(item->getMetadata().getID()))
+                    Loader::get()->isModInstalled(item->getMetadataRef().getIDRef()) ||
+                    Loader::get()->isModLoaded(item->getMetadataRef().getIDRef()))
                     continue;
                 // match the same as other installed mods
-                if (auto match = queryMatchKeywords(query, item->getMetadata())) {
+                if (auto match = queryMatchKeywords(query, item->getMetadataRef())) {
                     auto cell = IndexItemCell::create(item, this, m_display, this->getCellSize());
                     sorted.insert({ match.value(), cell });
                 }
             }
 
             // loaded
-            for (auto const& mod : Loader::get()->getAllMods()) {
+            for (auto const& mod : Loader::get()->getAllModsView()) {
                 if (auto match = queryMatch(query, mod)) {
                     auto cell = ModCell::create(mod, this, m_display, this->getCellSize());
                     sorted.insert({ match.value(), cell });
@@ -39,7 +39,7 @@ CCArray* ProblemsListPopup::createCells(Mod* scrollTo, float& scrollValue) {
     std::vector<ProblemsListCell*> middle;
     std::vector<ProblemsListCell*> bottom;
 
-    for (auto const& problem : Loader::get()->getProblems()) {
+    for (auto const& problem : Loader::get()->getProblemsView()) {
         switch (problem.type) {
             case geode::LoadProblem::Type::Suggestion:
                 bottom.push_back(ProblemsListCell::create(problem, this, this->getCellSize()));
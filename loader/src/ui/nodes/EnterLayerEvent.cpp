@@ -8,13 +8,24 @@ AEnterLayerEvent::AEnterLayerEvent(
 ) : layerID(layerID),
     layer(layer) {}
 
-ListenerResult AEnterLayerFilter::handle(utils::MiniFunction<Callback> fn, AEnterLayerEvent* event) {
+std::optional<std::string_view> AEnterLayerEvent::getRoutingKey() const {
+    return layerID;
+}
+
+ListenerResult AEnterLayerFilter::handle(utils::MiniFunction<Callback> const& fn, AEnterLayerEvent* event) {
     if (m_targetID == event->layerID) {
         fn(event);
     }
     return ListenerResult::Propagate;
 }
 
+std::optional<std::string_view> AEnterLayerFilter::getRoutingKey() const {
+    if (m_targetID) {
+        return *m_targetID;
+    }
+    return std::nullopt;
+}
+
 AEnterLayerFilter::AEnterLayerFilter(
     std::optional<std::string> const& id
 ) : m_targetID(id) {}
@@ -577,7 +577,7 @@ ghc::filesystem::path FileWatchEvent::getPath() const {
 }
 
 ListenerResult FileWatchFilter::handle(
-    MiniFunction<Callback> callback,
+    MiniFunction<Callback> const& callback,
     FileWatchEvent* event
 ) {
     std::error_code ec;
@@ -602,9 +602,7 @@ Result<> file::watchFile(ghc::filesystem::path const& file) {
     auto watcher = std::make_unique<FileWatcher>(
         file,
         [](auto const& path) {
-            Loader::get()->queueInMainThread([=] {
-                FileWatchEvent(path).post();
-            });
+            Event::postDeferred(FileWatchEvent(path));
         }
     );
     if (!watcher->watching()) {
@@ -482,24 +482,24 @@ AsyncWebResponse AsyncWebRequest::fetch(std::string const& url) {
 }
 
 AsyncWebRequest& AsyncWebRequest::expect(AsyncExpect handler) {
-    m_expect = [handler](std::string const& info, auto) {
+    m_expect = [handler = std::move(handler)](std::string const& info, auto) {
         return handler(info);
     };
     return *this;
 }
 
 AsyncWebRequest& AsyncWebRequest::expect(AsyncExpectCode handler) {
-    m_expect = handler;
+    m_expect = std::move(handler);
     return *this;
 }
 
 AsyncWebRequest& AsyncWebRequest::progress(AsyncProgress progress) {
-    m_progress = progress;
+    m_progress = std::move(progress);
     return *this;
 }
 
 AsyncWebRequest& AsyncWebRequest::cancelled(AsyncCancelled cancelledFunc) {
-    m_cancelled = cancelledFunc;
+    m_cancelled = std::move(cancelledFunc);
     return *this;
 }
 
@@ -520,10 +520,11 @@ SentAsyncWebRequestHandle AsyncWebRequest::send() {
     if (m_joinID && RUNNING_REQUESTS.count(m_joinID.value())) {
         auto& req = RUNNING_REQUESTS.at(m_joinID.value());
         std::lock_guard _(req->m_impl->m_mutex);
-        if (m_then) req->m_impl->m_thens.push_back(m_then);
-        if (m_progress) req->m_impl->m_progresses.push_back(m_progress);
-        if (m_expect) req->m_impl->m_expects.push_back(m_expect);
-        if (m_cancelled) req->m_impl->m_cancelleds.push_back(m_cancelled);
+        // the request has been sent so its callbacks can be handed over
+        if (m_then) req->m_impl->m_thens.push_back(std::move(m_then));
+        if (m_progress) req->m_impl->m_progresses.push_back(std::move(m_progress));
+        if (m_expect) req->m_impl->m_expects.push_back(std::move(m_expect));
+        if (m_cancelled) req->m_impl->m_cancelleds.push_back(std::move(m_cancelled));
         ret = req;
     }
     else {
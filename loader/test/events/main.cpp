@@ -0,0 +1,180 @@
+#include <Geode/Loader.hpp>
+#include <Geode/loader/Event.hpp>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <utility>
+
+using namespace geode::prelude;
+
+// Counts every allocation made through this mod's operator new. On Windows
+// this only sees allocations made by this binary, which includes the
+// EventListener and filter templates a post goes through
+static std::atomic_size_t s_allocations = 0;
+
+void* operator new(size_t size) {
+    s_allocations += 1;
+    if (auto p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+class AllocTestEvent : public Event {
+public:
+    int value;
+    AllocTestEvent(int value) : value(value) {}
+};
+
+class AllocTestFilter : public EventFilter<AllocTestEvent> {
+public:
+    ListenerResult handle(utils::MiniFunction<Callback> const& fn, AllocTestEvent* event) {
+        return fn(event);
+    }
+};
+
+// Old style filter that still takes the callback by value
+class AllocTestCopyFilter : public EventFilter<AllocTestEvent> {
+public:
+    ListenerResult handle(utils::MiniFunction<Callback> fn, AllocTestEvent* event) {
+        return fn(event);
+    }
+};
+
+static constexpr size_t LISTENER_COUNT = 100;
+static constexpr size_t POST_COUNT = 1000;
+
+template <class Filter>
+static size_t countPostAllocations() {
+    size_t received = 0;
+    // large enough that the callback doesn't fit in MiniFunction's inline
+    // storage, so every copy of it allocates
+    std::array<char, 64> padding {};
+    std::vector<std::unique_ptr<EventListener<Filter>>> listeners;
+    for (size_t i = 0; i < LISTENER_COUNT; i++) {
+        listeners.push_back(std::make_unique<EventListener<Filter>>(
+            [&received, padding](AllocTestEvent* event) {
+                received += event->value + padding[0];
+                return ListenerResult::Propagate;
+            }
+        ));
+    }
+
+    // the first post of a type fills the pool's route cache
+    AllocTestEvent(0).post();
+
+    auto before = s_allocations.load();
+    for (size_t i = 0; i < POST_COUNT; i++) {
+        AllocTestEvent(1).post();
+    }
+    auto allocations = s_allocations.load() - before;
+
+    if (received != LISTENER_COUNT * POST_COUNT) {
+        log::error("Expected {} deliveries, got {}", LISTENER_COUNT * POST_COUNT, received);
+    }
+    return allocations;
+}
+
+// One of several unrelated event types, so the pool has to route each post
+// to the listeners of its own type
+template <int Type>
+class MixedTestEvent : public Event {
+public:
+    int target;
+    MixedTestEvent(int target) : target(target) {}
+};
+
+template <int Type>
+class MixedTestFilter : public EventFilter<MixedTestEvent<Type>> {
+protected:
+    int m_target;
+
+public:
+    using Callback = ListenerResult(MixedTestEvent<Type>*);
+
+    MixedTestFilter(int target) : m_target(target) {}
+
+    ListenerResult handle(utils::MiniFunction<Callback> const& fn, MixedTestEvent<Type>* event) {
+        if (event->target == m_target) {
+            return fn(event);
+        }
+        return ListenerResult::Propagate;
+    }
+};
+
+static constexpr int MIXED_TYPE_COUNT = 10;
+static constexpr int MIXED_LISTENERS_PER_TYPE = 100;
+static constexpr size_t MIXED_POST_COUNT = 100000;
+
+template <int Type>
+static void addMixedListeners(std::vector<std::unique_ptr<EventListenerProtocol>>& listeners, size_t& received) {
+    for (int i = 0; i < MIXED_LISTENERS_PER_TYPE; i++) {
+        listeners.push_back(std::make_unique<EventListener<MixedTestFilter<Type>>>(
+            [&received](MixedTestEvent<Type>*) {
+                received += 1;
+                return ListenerResult::Propagate;
+            },
+            MixedTestFilter<Type>(i)
+        ));
+    }
+}
+
+template <int... Types>
+static void postMixed(int target, std::integer_sequence<int, Types...>) {
+    (MixedTestEvent<Types>(target).post(), ...);
+}
+
+// 1000 listeners spread over 10 event types, each of which only handles one
+// value of its type, with posts going round robin over the types
+static void benchmarkMixedListeners() {
+    constexpr auto types = std::make_integer_sequence<int, MIXED_TYPE_COUNT>();
+    size_t received = 0;
+    std::vector<std::unique_ptr<EventListenerProtocol>> listeners;
+    [&]<int... Types>(std::integer_sequence<int, Types...>) {
+        (addMixedListeners<Types>(listeners, received), ...);
+    }(types);
+
+    postMixed(0, types);
+
+    auto before = s_allocations.load();
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < MIXED_POST_COUNT / MIXED_TYPE_COUNT; i++) {
+        postMixed(i % MIXED_LISTENERS_PER_TYPE, types);
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start
+    );
+    auto allocations = s_allocations.load() - before;
+
+    log::info(
+        "{} posts to {} listeners over {} event types: {}ns per post, {} allocations",
+        MIXED_POST_COUNT, listeners.size(), MIXED_TYPE_COUNT,
+        elapsed.count() / MIXED_POST_COUNT, allocations
+    );
+    if (received != MIXED_POST_COUNT + MIXED_TYPE_COUNT) {
+        log::error("Expected {} deliveries, got {}", MIXED_POST_COUNT + MIXED_TYPE_COUNT, received);
+    }
+}
+
+$on_mod(Loaded) {
+    auto byRef = countPostAllocations<AllocTestFilter>();
+    auto byValue = countPostAllocations<AllocTestCopyFilter>();
+
+    log::info(
+        "{} posts to {} listeners: {} allocations by reference, {} by value",
+        POST_COUNT, LISTENER_COUNT, byRef, byValue
+    );
+    if (byRef != 0) {
+        log::error("Posting allocated {} times with a by-reference filter", byRef);
+    }
+
+    benchmarkMixedListeners();
+}
@@ -0,0 +1,176 @@
+#include <Geode/Loader.hpp>
+#include "../../src/loader/ModGraph.hpp"
+#include <chrono>
+#include <memory>
+
+using namespace geode::prelude;
+
+// Stands in for a mod: its required dependencies, and the mods requiring it
+struct TestNode {
+    size_t id;
+    std::vector<TestNode*> dependencies;
+    std::vector<TestNode*> dependants;
+};
+
+struct TestGraph {
+    std::vector<std::unique_ptr<TestNode>> storage;
+    std::vector<TestNode*> nodes;
+
+    TestGraph(size_t count) {
+        for (size_t i = 0; i < count; i++) {
+            storage.push_back(std::make_unique<TestNode>(TestNode { i }));
+            nodes.push_back(storage.back().get());
+        }
+    }
+
+    void depend(size_t node, size_t on) {
+        nodes[node]->dependencies.push_back(nodes[on]);
+        nodes[on]->dependants.push_back(nodes[node]);
+    }
+};
+
+static constexpr size_t NODE_COUNT = 1000;
+
+static size_t s_failures = 0;
+
+static void check(bool passed, std::string_view what) {
+    if (!passed) {
+        s_failures += 1;
+        log::error("Mod graph: {} failed", what);
+    }
+}
+
+// Sorts the graph and finds the cycles among what's left, the same way
+// Loader::Impl::sortModGraph does
+static std::pair<mod_graph::Order<TestNode*>, std::unordered_map<TestNode*, size_t>> sortGraph(
+    TestGraph const& graph
+) {
+    auto sorted = mod_graph::sort<TestNode*>(graph.nodes, [](TestNode* node, auto&& visit) {
+        for (auto dependant : node->dependants) {
+            visit(dependant);
+        }
+    });
+    std::vector<TestNode*> blocked;
+    for (auto node : graph.nodes) {
+        if (sorted.blocked.contains(node)) {
+            blocked.push_back(node);
+        }
+    }
+    auto components = mod_graph::components<TestNode*>(blocked, [&](TestNode* node, auto&& visit) {
+        for (auto dep : node->dependencies) {
+            if (sorted.blocked.contains(dep)) {
+                visit(dep);
+            }
+        }
+    });
+    return { std::move(sorted), std::move(components) };
+}
+
+static bool isOrdered(std::vector<TestNode*> const& order) {
+    std::vector<size_t> position(order.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        position[order[i]->id] = i;
+    }
+    for (auto node : order) {
+        for (auto dep : node->dependencies) {
+            if (position[dep->id] > position[node->id]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static void benchmark(std::string_view name, TestGraph const& graph) {
+    constexpr size_t RUNS = 100;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < RUNS; i++) {
+        sortGraph(graph);
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start
+    );
+    log::info("Sorting {}: {}us per sort", name, elapsed.count() / RUNS);
+}
+
+// 1000 mods, each requiring the one before it
+static TestGraph createChain() {
+    TestGraph graph(NODE_COUNT);
+    for (size_t i = 1; i < NODE_COUNT; i++) {
+        graph.depend(i, i - 1);
+    }
+    return graph;
+}
+
+// 20 layers of 50 mods, each requiring two mods of the layer below
+static TestGraph createLayers() {
+    constexpr size_t WIDTH = 50;
+    TestGraph graph(NODE_COUNT);
+    for (size_t i = WIDTH; i < NODE_COUNT; i++) {
+        auto below = i / WIDTH * WIDTH - WIDTH;
+        graph.depend(i, below + i % WIDTH);
+        graph.depend(i, below + (i + 1) % WIDTH);
+    }
+    return graph;
+}
+
+// the chain, except every 100th mod also requires the last mod of its own
+// group of 100, closing 10 cycles. the first mod requires a mod of the
+// first cycle without being part of it
+static TestGraph createCycles() {
+    TestGraph graph(NODE_COUNT + 1);
+    for (size_t i = 1; i < NODE_COUNT; i++) {
+        if (i % 100 != 0) {
+            graph.depend(i, i - 1);
+        }
+    }
+    for (size_t i = 0; i < NODE_COUNT; i += 100) {
+        graph.depend(i, i + 99);
+    }
+    graph.depend(NODE_COUNT, 50);
+    return graph;
+}
+
+$on_mod(Loaded) {
+    auto chain = createChain();
+    auto [chainSorted, chainComponents] = sortGraph(chain);
+    check(
+        chainSorted.order.size() == NODE_COUNT && chainSorted.blocked.empty() && isOrdered(chainSorted.order),
+        "sorting a chain"
+    );
+
+    auto layers = createLayers();
+    auto [layersSorted, layersComponents] = sortGraph(layers);
+    check(
+        layersSorted.order.size() == NODE_COUNT && layersSorted.blocked.empty() && isOrdered(layersSorted.order),
+        "sorting layers"
+    );
+
+    auto cycles = createCycles();
+    auto [cyclesSorted, cyclesComponents] = sortGraph(cycles);
+    check(
+        cyclesSorted.order.empty() && cyclesSorted.blocked.size() == NODE_COUNT + 1,
+        "blocking every mod on a cycle"
+    );
+    bool grouped = true;
+    for (size_t i = 0; i < NODE_COUNT; i++) {
+        grouped &= cyclesComponents[cycles.nodes[i]] == cyclesComponents[cycles.nodes[i / 100 * 100]];
+        grouped &= cyclesComponents[cycles.nodes[i]] != cyclesComponents[cycles.nodes[(i + 100) % NODE_COUNT]];
+    }
+    check(grouped, "grouping each cycle into its own component");
+    check(
+        cyclesComponents[cycles.nodes[NODE_COUNT]] != cyclesComponents[cycles.nodes[50]],
+        "keeping a mod that depends on a cycle out of it"
+    );
+
+    benchmark("a 1000 mod chain", chain);
+    benchmark("20 layers of 50 mods", layers);
+    benchmark("10 cycles of 100 mods", cycles);
+
+    if (s_failures) {
+        log::error("Mod graph: {} checks failed", s_failures);
+    }
+    else {
+        log::info("Mod graph: all checks passed");
+    }
+}
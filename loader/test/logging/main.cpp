@@ -0,0 +1,78 @@
+#include <Geode/Loader.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+using namespace geode::prelude;
+
+// Counts every allocation made through this mod's operator new. On Windows
+// this only sees allocations made by this binary, which includes capturing
+// the arguments of a log call but not formatting or storing the log
+static std::atomic_size_t s_allocations = 0;
+
+void* operator new(size_t size) {
+    s_allocations += 1;
+    if (auto p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+// Kept low since every one of these ends up in the log
+static constexpr size_t LOGGED_CALLS = 100;
+static constexpr size_t FILTERED_CALLS = 100000;
+
+template <class F>
+static std::pair<double, double> measure(size_t calls, F&& func) {
+    auto before = s_allocations.load();
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < calls; i++) {
+        func(i);
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start
+    );
+    auto allocations = s_allocations.load() - before;
+    return {
+        static_cast<double>(elapsed.count()) / calls,
+        static_cast<double>(allocations) / calls
+    };
+}
+
+// log::debug with a string, an integer and a float, like a progress message
+static void benchmarkDebugLog() {
+    // longer than the small string buffer, so copying it allocates
+    std::string name = "geode.some-example-mod";
+    auto call = [&](size_t i) {
+        log::debug("Loading {} ({}/{})", name, i, i * 0.5f);
+    };
+
+    log::Logger::setMinimumSeverity(Mod::get(), Severity::Debug);
+    auto [loggedTime, loggedAllocs] = measure(LOGGED_CALLS, call);
+
+    log::Logger::setMinimumSeverity(Mod::get(), Severity::Info);
+    auto [filteredTime, filteredAllocs] = measure(FILTERED_CALLS, call);
+
+    log::Logger::setMinimumSeverity(Mod::get(), std::nullopt);
+
+    log::info(
+        "log::debug with 3 args: {:.0f}ns and {:.1f} allocations per logged call, "
+        "{:.0f}ns and {:.1f} allocations per filtered call",
+        loggedTime, loggedAllocs, filteredTime, filteredAllocs
+    );
+    if (filteredAllocs != 0) {
+        log::error("Filtered log calls allocated {:.1f} times per call", filteredAllocs);
+    }
+}
+
+$on_mod(Loaded) {
+    benchmarkDebugLog();
+}
@@ -0,0 +1,140 @@
+#include <Geode/Loader.hpp>
+#include <Geode/utils/ranges.hpp>
+
+#define FTS_FUZZY_MATCH_IMPLEMENTATION
+#include <Geode/external/fts/fts_fuzzy_match.h>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <unordered_set>
+
+using namespace geode::prelude;
+
+// Counts every allocation made through this mod's operator new. On Windows
+// this only sees allocations made by this binary, which doesn't include the
+// copies made inside the loader by the copying getters
+static std::atomic_size_t s_allocations = 0;
+
+void* operator new(size_t size) {
+    s_allocations += 1;
+    if (auto p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+static constexpr size_t ITEM_COUNT = 500;
+static constexpr auto KEYWORDS = "mod long";
+
+// An index item as the mod list sees it
+struct TestItem {
+    ModMetadata metadata;
+    std::unordered_set<std::string> tags;
+};
+
+static std::optional<int> fuzzyMatch(std::string const& kw, std::string const& str) {
+    int score;
+    if (fts::fuzzy_match(kw.c_str(), str.c_str(), score)) {
+        return score;
+    }
+    return std::nullopt;
+}
+
+static std::optional<int> fuzzyMatch(std::string const& kw, std::optional<std::string> const& str) {
+    int score;
+    if (fts::fuzzy_match(kw.c_str(), str ? str->c_str() : "", score)) {
+        return score;
+    }
+    return std::nullopt;
+}
+
+// The keyword pass of the mod list filter, through the getters that return
+// copies like it did before the copy-free accessors
+static int matchCopying(std::string const& kw, TestItem const& item) {
+    auto metadata = item.metadata;
+    int best = 0;
+    for (auto match : {
+        fuzzyMatch(kw, metadata.getName()),
+        fuzzyMatch(kw, metadata.getID()),
+        fuzzyMatch(kw, metadata.getDeveloper()),
+        fuzzyMatch(kw, metadata.getDetails().value_or("")),
+        fuzzyMatch(kw, metadata.getDescription().value_or(""))
+    }) {
+        best = std::max(best, match.value_or(0));
+    }
+    auto tags = item.tags;
+    return best + fuzzyMatch(kw, ranges::join(tags, " ")).value_or(0);
+}
+
+// The same pass through the accessors the mod list uses now
+static int matchByRef(std::string const& kw, TestItem const& item) {
+    auto& metadata = item.metadata;
+    int best = 0;
+    for (auto match : {
+        fuzzyMatch(kw, metadata.getNameRef()),
+        fuzzyMatch(kw, metadata.getIDRef()),
+        fuzzyMatch(kw, metadata.getDeveloperRef()),
+        fuzzyMatch(kw, metadata.getDetailsRef()),
+        fuzzyMatch(kw, metadata.getDescriptionRef())
+    }) {
+        best = std::max(best, match.value_or(0));
+    }
+    return best + fuzzyMatch(kw, ranges::join(item.tags, " ")).value_or(0);
+}
+
+static std::vector<TestItem> createItems() {
+    std::vector<TestItem> items;
+    for (size_t i = 0; i < ITEM_COUNT; i++) {
+        TestItem item { ModMetadata(fmt::format("developer.some-mod-number-{}", i)) };
+        item.metadata.setName(fmt::format("Some Mod With A Long Name {}", i));
+        item.metadata.setDeveloper("Some Developer With A Long Name");
+        item.metadata.setDescription("A description that is long enough not to fit in SSO");
+        item.metadata.setDetails(std::string(600, 'x'));
+        item.metadata.setSpritesheets({ "sheet-one-with-a-long-name", "sheet-two-with-a-long-name" });
+        std::vector<ModMetadata::Dependency> dependencies(3);
+        for (auto& dependency : dependencies) {
+            dependency.id = "developer.some-dependency-id";
+        }
+        item.metadata.setDependencies(dependencies);
+        item.tags = { "gameplay", "interface", "performance-related" };
+        items.push_back(std::move(item));
+    }
+    return items;
+}
+
+template <class F>
+static std::pair<size_t, size_t> measurePass(std::vector<TestItem> const& items, F&& match) {
+    std::string kw = KEYWORDS;
+    int total = 0;
+    auto before = s_allocations.load();
+    auto start = std::chrono::steady_clock::now();
+    for (auto& item : items) {
+        total += match(kw, item);
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start
+    );
+    auto allocations = s_allocations.load() - before;
+    if (total == 0) {
+        log::error("No item matched \"{}\"", kw);
+    }
+    return { elapsed.count(), allocations };
+}
+
+$on_mod(Loaded) {
+    auto items = createItems();
+    auto [copyingTime, copyingAllocs] = measurePass(items, &matchCopying);
+    auto [byRefTime, byRefAllocs] = measurePass(items, &matchByRef);
+    log::info(
+        "Filtering {} mod list items: {}us and {} allocations with copies, "
+        "{}us and {} allocations by reference",
+        ITEM_COUNT, copyingTime, copyingAllocs, byRefTime, byRefAllocs
+    );
+}
@@ -0,0 +1,152 @@
+#include <Geode/Loader.hpp>
+#include <Geode/utils/MiniFunction.hpp>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <new>
+
+using namespace geode::prelude;
+
+// Counts every allocation made through this mod's operator new
+static std::atomic_size_t s_allocations = 0;
+
+void* operator new(size_t size) {
+    s_allocations += 1;
+    if (auto p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+static size_t s_failures = 0;
+
+static void check(bool passed, std::string_view what) {
+    if (!passed) {
+        s_failures += 1;
+        log::error("MiniFunction: {} failed", what);
+    }
+}
+
+template <class F>
+static size_t countAllocations(F&& func) {
+    auto before = s_allocations.load();
+    func();
+    return s_allocations.load() - before;
+}
+
+struct Counter {
+    int value = 0;
+    int add(int by) {
+        return value += by;
+    }
+};
+
+static void testInlineStorage() {
+    // three captured pointers is the most that's stored inline
+    int a = 1, b = 2, c = 3;
+    int* pa = &a;
+    int* pb = &b;
+    int* pc = &c;
+    auto small = [pa, pb, pc]() { return *pa + *pb + *pc; };
+    check(countAllocations([&] {
+        utils::MiniFunction<int()> fn = small;
+        auto copy = fn;
+        auto moved = std::move(copy);
+        check(fn() == 6 && moved() == 6, "calling an inline function");
+    }) == 0, "storing three pointers inline");
+
+    int* pd = &a;
+    auto large = [pa, pb, pc, pd]() { return *pa + *pb + *pc + *pd; };
+    check(countAllocations([&] {
+        utils::MiniFunction<int()> fn = large;
+        check(fn() == 7, "calling a heap function");
+    }) == 1, "storing four pointers on the heap");
+    check(countAllocations([&] {
+        utils::MiniFunction<int()> fn = large;
+        auto moved = std::move(fn);
+        check(!fn && moved() == 7, "moving a heap function");
+    }) == 1, "moving a heap function without reallocating");
+
+    // plain and member function pointers always fit
+    check(countAllocations([&] {
+        utils::MiniFunction<int(int)> fn = +[](int x) { return x * 2; };
+        check(fn(21) == 42, "calling a function pointer");
+        utils::MiniFunction<int(Counter*, int)> member = &Counter::add;
+        Counter counter;
+        member(&counter, 2);
+        check(member(&counter, 3) == 5, "calling a member function pointer");
+    }) == 0, "storing function pointers inline");
+}
+
+static void testMoveMiniFunction() {
+    auto owned = std::make_unique<int>(5);
+    utils::MoveMiniFunction<int()> fn = [owned = std::move(owned)]() { return *owned; };
+    auto moved = std::move(fn);
+    check(!fn && moved() == 5, "moving a move-only callable");
+
+    utils::MiniFunction<int()> copyable = [] { return 1; };
+    utils::MoveMiniFunction<int()> fromCopy = copyable;
+    check(copyable() == 1 && fromCopy() == 1, "converting a MiniFunction");
+
+    utils::MoveMiniFunction<int()> empty = nullptr;
+    check(!empty && empty() == 0, "calling an empty function");
+}
+
+static void benchmarkCopies() {
+    constexpr size_t COPIES = 100000;
+    int a = 0;
+    int* pa = &a;
+    std::array<int*, 3> small { pa, pa, pa };
+    std::array<int*, 8> large { pa, pa, pa, pa, pa, pa, pa, pa };
+
+    auto time = [](auto fn) {
+        auto start = std::chrono::steady_clock::now();
+        auto allocations = countAllocations([&] {
+            for (size_t i = 0; i < COPIES; i++) {
+                auto copy = fn;
+                copy();
+            }
+        });
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start
+        );
+        return std::pair(elapsed.count(), allocations);
+    };
+
+    auto [smallTime, smallAllocs] = time(utils::MiniFunction<void()>([small] { *small[0] += 1; }));
+    auto [largeTime, largeAllocs] = time(utils::MiniFunction<void()>([large] { *large[0] += 1; }));
+    log::info(
+        "{} MiniFunction copies: inline {}us ({} allocations), heap {}us ({} allocations)",
+        COPIES, smallTime, smallAllocs, largeTime, largeAllocs
+    );
+
+    // the same captures through std::function, whose inline storage depends 
+    // on the standard library
+    auto [stdSmallTime, stdSmallAllocs] = time(std::function<void()>([small] { *small[0] += 1; }));
+    auto [stdLargeTime, stdLargeAllocs] = time(std::function<void()>([large] { *large[0] += 1; }));
+    log::info(
+        "{} std::function copies: 3 pointers {}us ({} allocations), 8 pointers {}us ({} allocations)",
+        COPIES, stdSmallTime, stdSmallAllocs, stdLargeTime, stdLargeAllocs
+    );
+}
+
+$on_mod(Loaded) {
+    testInlineStorage();
+    testMoveMiniFunction();
+    benchmarkCopies();
+    if (s_failures) {
+        log::error("MiniFunction: {} checks failed", s_failures);
+    }
+    else {
+        log::info("MiniFunction: all checks passed");
+    }
+}